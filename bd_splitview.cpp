@@ -9,5 +9,24 @@
 
 #include <bd_splitview/bd_splitview.h>
 
+#include "src/WorkerPool.cpp"
+#include "src/PixelKernels.cpp"
+#include "src/TileHashMap.cpp"
+#include "src/DiffMetrics.cpp"
+#include "src/DifferenceRegions.cpp"
+#include "src/AutoAligner.cpp"
+#include "src/PaintProfiler.cpp"
+#include "src/RepaintHeatmap.cpp"
+#include "src/ReferenceImageComponent.cpp"
+#include "src/FrameRecorder.cpp"
+#include "src/FrameHistory.cpp"
+#include "src/SharedFrameChannel.cpp"
+#include "src/SharedFrameComponent.cpp"
+#include "src/SplitViewSuspendable.cpp"
+#include "src/InputMirror.cpp"
+#include "src/DividerGeometry.cpp"
+#include "src/OffscreenBufferPool.cpp"
+#include "src/ClippedComponentImage.cpp"
 #include "src/ClippingRegionEffect.cpp"
-#include "src/SplitView.cpp"
\ No newline at end of file
+#include "src/SplitView.cpp"
+#include "src/BatchComparer.cpp"
\ No newline at end of file
@@ -14,5 +14,25 @@ END_JUCE_MODULE_DECLARATION
 
 #include <juce_gui_basics/juce_gui_basics.h>
 
+#include "src/WorkerPool.h"
+#include "src/CoalescingJob.h"
+#include "src/PixelKernels.h"
+#include "src/TileHashMap.h"
+#include "src/DiffMetrics.h"
+#include "src/DifferenceRegions.h"
+#include "src/AutoAligner.h"
+#include "src/PaintProfiler.h"
+#include "src/RepaintHeatmap.h"
+#include "src/ReferenceImageComponent.h"
+#include "src/FrameRecorder.h"
+#include "src/FrameHistory.h"
+#include "src/SharedFrameChannel.h"
+#include "src/SharedFrameComponent.h"
+#include "src/SplitViewSuspendable.h"
+#include "src/InputMirror.h"
+#include "src/DividerGeometry.h"
+#include "src/OffscreenBufferPool.h"
+#include "src/ClippedComponentImage.h"
 #include "src/ClippingRegionEffect.h"
-#include "src/SplitView.h"
\ No newline at end of file
+#include "src/SplitView.h"
+#include "src/BatchComparer.h"
\ No newline at end of file
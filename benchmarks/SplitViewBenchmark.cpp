@@ -0,0 +1,281 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+// Measures the overhead of SplitView itself: resizing, switching view modes,
+// dragging the divider and painting, in each rendering mode, and estimating an
+// alignment, with synthetic children of configurable size and paint cost.
+// Prints JSON with a fixed layout, so results of two builds can be diffed.
+//
+//   bd_splitview_benchmark [--width=1200] [--height=800] [--scale=2]
+//                          [--cost=500] [--iterations=50] [--output=file.json]
+
+#include <bd_splitview/bd_splitview.h>
+#include <iostream>
+#include <numeric>
+
+using BogrenDigital::SplitView;
+
+namespace
+{
+    /** Paints a fixed number of primitives spread over its bounds. */
+    class SyntheticComponent : public juce::Component
+    {
+    public:
+        SyntheticComponent (int numPrimitives, juce::uint32 seed)
+            : primitives (numPrimitives), colourSeed (seed)
+        {
+        }
+
+        void paint (juce::Graphics& g) override
+        {
+            juce::Random random ((juce::int64) colourSeed);
+            g.fillAll (juce::Colour (0xff202020));
+
+            for (auto i = 0; i < primitives; ++i)
+            {
+                const auto x = random.nextFloat() * (float) getWidth();
+                const auto y = random.nextFloat() * (float) getHeight();
+                g.setColour (juce::Colour (random.nextInt() | 0xff000000u).withAlpha (0.7f));
+
+                if (i % 2 == 0)
+                    g.fillEllipse (x, y, 24.0f, 24.0f);
+                else
+                    g.drawLine (x, y, x + 40.0f, y + 12.0f, 2.0f);
+            }
+        }
+
+    private:
+        const int primitives;
+        const juce::uint32 colourSeed;
+    };
+
+    struct Config
+    {
+        int width = 1200, height = 800;
+        float scale = 2.0f;
+        int cost = 500;
+        int iterations = 50;
+        juce::File output; // Prints to stdout if not set
+    };
+
+    /**
+     * Returns the number given as --option=value. Anything else fails, since
+     * a run that quietly measured another configuration would still look fine.
+     */
+    template <typename Number>
+    Number getNumberForOption (const juce::ArgumentList& args, const juce::String& option, Number defaultValue, Number minimum, Number maximum)
+    {
+        if (!args.containsOption (option))
+            return defaultValue;
+
+        // ArgumentList only reads the value of a long option after an '='
+        const auto text = args.getValueForOption (option).trim();
+        const auto value = text.getDoubleValue();
+        const auto isNumber = text.isNotEmpty() && text.containsOnly (std::is_integral_v<Number> ? "+-0123456789" : "+-.0123456789eE");
+        if (!isNumber || value < (double) minimum || value > (double) maximum)
+            juce::ConsoleApplication::fail (option + "=" + text + " isn't a " + (std::is_integral_v<Number> ? "whole " : "") + "number from "
+                                                + juce::String (minimum) + " to " + juce::String (maximum),
+                                            2);
+
+        return (Number) value;
+    }
+
+    Config parseConfig (const juce::ArgumentList& args)
+    {
+        Config config;
+        config.width = getNumberForOption (args, "--width", config.width, 16, 16384);
+        config.height = getNumberForOption (args, "--height", config.height, 16, 16384);
+        config.scale = getNumberForOption (args, "--scale", config.scale, 0.5f, 4.0f);
+        config.cost = getNumberForOption (args, "--cost", config.cost, 0, 1000000);
+        config.iterations = getNumberForOption (args, "--iterations", config.iterations, 1, 1000000);
+
+        if (args.containsOption ("--output"))
+            config.output = args.getFileForOption ("--output");
+
+        return config;
+    }
+
+    /** Times body, which is called with the iteration index, after a few warm-up calls. */
+    juce::var measure (const juce::String& name, const juce::String& mode, const Config& config, const std::function<void (int)>& body)
+    {
+        for (auto i = 0; i < 3; ++i)
+            body (i);
+
+        std::vector<double> times;
+        times.reserve ((size_t) config.iterations);
+        for (auto i = 0; i < config.iterations; ++i)
+        {
+            const auto start = juce::Time::getHighResolutionTicks();
+            body (i);
+            times.push_back (juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start) * 1.0e6);
+        }
+
+        std::sort (times.begin(), times.end());
+        const auto round = [] (double microseconds) { return std::round (microseconds * 100.0) / 100.0; };
+        const auto percentile = [&times] (double p) { return times[juce::jmin (times.size() - 1, (size_t) (p / 100.0 * (double) times.size()))]; };
+
+        auto* result = new juce::DynamicObject();
+        result->setProperty ("name", name);
+        result->setProperty ("renderingMode", mode);
+        result->setProperty ("minUs", round (times.front()));
+        result->setProperty ("medianUs", round (percentile (50.0)));
+        result->setProperty ("p95Us", round (percentile (95.0)));
+        result->setProperty ("meanUs", round (std::accumulate (times.begin(), times.end(), 0.0) / (double) times.size()));
+        return result;
+    }
+
+    /** Paints view into image at the configured scale, optionally limited to area. */
+    void paintView (SplitView& view, juce::Image& image, float scale, juce::Rectangle<int> area = {})
+    {
+        juce::Graphics g (image);
+        g.addTransform (juce::AffineTransform::scale (scale));
+        if (!area.isEmpty())
+            g.reduceClipRegion (area);
+
+        view.paintEntireComponent (g, true);
+    }
+
+    juce::String getName (SplitView::RenderingMode mode)
+    {
+        switch (mode)
+        {
+            case SplitView::RenderingMode::DirectClip:
+                return "DirectClip";
+            case SplitView::RenderingMode::Snapshot:
+                return "Snapshot";
+            case SplitView::RenderingMode::ComponentEffect:
+                return "ComponentEffect";
+        }
+
+        return {};
+    }
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args (argc, argv);
+
+    // A bad option fails with a message and exit code rather than an uncaught exception
+    Config config;
+    if (const auto exitCode = juce::ConsoleApplication::invokeCatchingFailures ([&] {
+            config = parseConfig (args);
+            return 0;
+        });
+        exitCode != 0)
+        return exitCode;
+
+    SyntheticComponent componentA (config.cost, 1), componentB (config.cost, 2);
+    SplitView view;
+    view.setVisible (true);
+    view.setDisplayedComponent (&componentA, true);
+    view.setDisplayedComponent (&componentB, false);
+    view.setSize (config.width, config.height);
+
+    juce::Image image (juce::Image::ARGB, juce::roundToInt ((float) config.width * config.scale), juce::roundToInt ((float) config.height * config.scale), true);
+    juce::Array<juce::var> results;
+
+    for (const auto mode : { SplitView::RenderingMode::DirectClip, SplitView::RenderingMode::Snapshot, SplitView::RenderingMode::ComponentEffect })
+    {
+        const auto modeName = getName (mode);
+        view.setRenderingMode (mode);
+        view.setViewMode (SplitView::ViewMode::Split);
+        view.setDividerPosition (0, 0.5f);
+        paintView (view, image, config.scale);
+
+        results.add (measure ("resize", modeName, config, [&] (int i) {
+            view.setSize (config.width - (i % 2), config.height - (i % 2));
+        }));
+        view.setSize (config.width, config.height);
+
+        results.add (measure ("setViewMode", modeName, config, [&] (int i) {
+            static constexpr SplitView::ViewMode cycle[] { SplitView::ViewMode::A, SplitView::ViewMode::B, SplitView::ViewMode::Difference, SplitView::ViewMode::Blend, SplitView::ViewMode::Split };
+            view.setViewMode (cycle[i % 5]);
+        }));
+        view.setViewMode (SplitView::ViewMode::Split);
+
+        // Moves the divider and paints the strip it swept, as a drag does
+        results.add (measure ("dividerDrag", modeName, config, [&] (int i) {
+            const auto oldX = view.getDividerPosition (0) * (float) config.width;
+            view.setDividerPosition (0, 0.2f + 0.6f * (float) (i % 32) / 31.0f);
+            const auto newX = view.getDividerPosition (0) * (float) config.width;
+
+            const auto left = (int) std::floor (juce::jmin (oldX, newX)) - 20;
+            const auto right = (int) std::ceil (juce::jmax (oldX, newX)) + 20;
+            paintView (view, image, config.scale, juce::Rectangle<int>::leftTopRightBottom (left, 0, right, config.height));
+        }));
+        view.setDividerPosition (0, 0.5f);
+
+        results.add (measure ("paintUnchanged", modeName, config, [&] (int) {
+            paintView (view, image, config.scale);
+        }));
+
+        results.add (measure ("paintChanged", modeName, config, [&] (int) {
+            componentA.repaint();
+            componentB.repaint();
+            paintView (view, image, config.scale);
+        }));
+    }
+
+    view.setViewMode (SplitView::ViewMode::Difference);
+    results.add (measure ("paintDifference", "Composite", config, [&] (int) {
+        componentA.repaint();
+        componentB.repaint();
+        paintView (view, image, config.scale);
+    }));
+
+    // A frame against a scaled and shifted copy of itself, at the physical size of the view
+    {
+        SyntheticComponent source (config.cost, 3);
+        source.setSize (config.width, config.height);
+
+        juce::Image frameA (juce::Image::ARGB, image.getWidth(), image.getHeight(), true);
+        juce::Image frameB (juce::Image::ARGB, image.getWidth(), image.getHeight(), true);
+        {
+            juce::Graphics g (frameA);
+            g.addTransform (juce::AffineTransform::scale (config.scale));
+            source.paintEntireComponent (g, true);
+        }
+        {
+            juce::Graphics g (frameB);
+            g.drawImageTransformed (frameA, juce::AffineTransform::scale (1.05f).translated (12.0f, -7.0f));
+        }
+
+        juce::SharedResourcePointer<BogrenDigital::WorkerPool> workerPool;
+        results.add (measure ("autoAlign", "Estimate", config, [&] (int) {
+            BogrenDigital::Alignment::estimate (frameA, frameB, *workerPool);
+        }));
+    }
+
+    auto* configObject = new juce::DynamicObject();
+    configObject->setProperty ("width", config.width);
+    configObject->setProperty ("height", config.height);
+    configObject->setProperty ("scale", config.scale);
+    configObject->setProperty ("cost", config.cost);
+    configObject->setProperty ("iterations", config.iterations);
+
+    auto* root = new juce::DynamicObject();
+    root->setProperty ("version", 1);
+    root->setProperty ("config", configObject);
+    root->setProperty ("results", results);
+
+    const auto json = juce::JSON::toString (juce::var (root), false, 2) + "\n";
+
+    if (config.output != juce::File())
+    {
+        if (!config.output.replaceWithText (json))
+        {
+            std::cerr << "Couldn't write " << config.output.getFullPathName() << "\n";
+            return 1;
+        }
+    }
+    else
+    {
+        std::cout << json;
+    }
+
+    return 0;
+}
@@ -0,0 +1,120 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+namespace BogrenDigital
+{
+    /**
+     * @brief Selects which of two processors is heard, with an equal-power
+     * crossfade between them, for comparing DSP alongside a SplitView.
+     * @details select() may be called from any thread; the audio thread
+     * picks the request up at the start of its next block through an atomic,
+     * and the crossfade starts on that block's first sample. Both processors
+     * run on every block, so the one that fades in has a warm state. A
+     * switch back during a fade reverses it from where it is, so the gains
+     * stay continuous. process() doesn't allocate or lock, as long as the
+     * channel count stays within what prepare() was given.
+     */
+    class ABAudioSwitch
+    {
+    public:
+        enum class Side { A,
+            B };
+
+        ABAudioSwitch() = default;
+
+        /** Allocates the buffer B renders into. Call before processing starts. */
+        void prepare (double sampleRate, int maximumBlockSize, int numChannels)
+        {
+            bufferB.setSize (numChannels, juce::jmax (1, maximumBlockSize));
+            fadeStep = 1.0f / (float) juce::jmax (1.0, sampleRate * fadeSeconds);
+            fadePosition = target = requestedSide.load() == Side::B ? 1.0f : 0.0f;
+        }
+
+        /** Sets the length of the crossfade. Takes effect on the next prepare(). Default is 20 ms. */
+        void setFadeLength (double seconds) { fadeSeconds = juce::jmax (0.0, seconds); }
+
+        /** Requests the side to be heard. Real-time safe, and callable from any thread. */
+        void select (Side side) { requestedSide.store (side, std::memory_order_release); }
+        Side getSelectedSide() const { return requestedSide.load (std::memory_order_acquire); }
+
+        /**
+         * @brief Runs both processors on the input in buffer and leaves the
+         * mix of their outputs in it.
+         * @param processA Called as processA (juce::AudioBuffer<float>&) to
+         * process in place. Use a lambda or reference, not a std::function, to
+         * keep the call free of allocations.
+         */
+        template <typename ProcessA, typename ProcessB>
+        void process (juce::AudioBuffer<float>& buffer, ProcessA&& processA, ProcessB&& processB)
+        {
+            target = requestedSide.load (std::memory_order_acquire) == Side::B ? 1.0f : 0.0f;
+
+            const auto numChannels = juce::jmin (buffer.getNumChannels(), bufferB.getNumChannels());
+            jassert (numChannels == buffer.getNumChannels()); // Prepared for fewer channels than this
+
+            // Hosts may exceed the block size they announced, so longer blocks are split
+            for (auto start = 0; start < buffer.getNumSamples(); start += bufferB.getNumSamples())
+            {
+                const auto numSamples = juce::jmin (bufferB.getNumSamples(), buffer.getNumSamples() - start);
+                juce::AudioBuffer<float> a (buffer.getArrayOfWritePointers(), numChannels, start, numSamples);
+                juce::AudioBuffer<float> b (bufferB.getArrayOfWritePointers(), numChannels, 0, numSamples);
+
+                for (auto channel = 0; channel < numChannels; ++channel)
+                    b.copyFrom (channel, 0, a, channel, 0, numSamples);
+
+                processA (a);
+                processB (b);
+                mix (a, b);
+            }
+        }
+
+    private:
+        void mix (juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+        {
+            const auto numSamples = a.getNumSamples();
+
+            if (fadePosition == target)
+            {
+                if (target == 1.0f)
+                    for (auto channel = 0; channel < a.getNumChannels(); ++channel)
+                        a.copyFrom (channel, 0, b, channel, 0, numSamples);
+                return;
+            }
+
+            // Equal power: cos² + sin² = 1, so the loudness stays level through the fade
+            for (auto i = 0; i < numSamples; ++i)
+            {
+                fadePosition = fadePosition < target ? juce::jmin (target, fadePosition + fadeStep)
+                                                     : juce::jmax (target, fadePosition - fadeStep);
+                const auto angle = fadePosition * juce::MathConstants<float>::halfPi;
+                const auto gainA = std::cos (angle);
+                const auto gainB = std::sin (angle);
+
+                for (auto channel = 0; channel < a.getNumChannels(); ++channel)
+                {
+                    auto* out = a.getWritePointer (channel);
+                    out[i] = out[i] * gainA + b.getSample (channel, i) * gainB;
+                }
+            }
+        }
+
+        std::atomic<Side> requestedSide { Side::A };
+        static_assert (std::atomic<Side>::is_always_lock_free);
+
+        // Only touched by the audio thread after prepare()
+        juce::AudioBuffer<float> bufferB;
+        double fadeSeconds = 0.02;
+        float fadeStep = 1.0f;
+        float fadePosition = 0.0f; // 0 is only A, 1 is only B
+        float target = 0.0f;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ABAudioSwitch)
+    };
+} // namespace BogrenDigital
@@ -0,0 +1,125 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+// Compares every PNG in a directory of references with the PNG of the same
+// name in a directory of actual renders, e.g. written by a test suite with
+// BatchComparer::render(), and exits with 1 if any of them differ.
+//
+//   bd_splitview_compare --reference=<dir> --actual=<dir> [--output=<dir>]
+//                        [--tolerance=<0-255>] [--max-different=<fraction>]
+//                        [--update]
+
+#include <bd_splitview/bd_splitview.h>
+#include <iostream>
+
+namespace
+{
+    void printUsage()
+    {
+        std::cout << "Usage: bd_splitview_compare --reference=<dir> --actual=<dir> [--output=<dir>]\n"
+                     "                            [--tolerance=<0-255>] [--max-different=<fraction>] [--update]\n"
+                     "\n"
+                     "  --output         Where the renders and diff images of failures are written\n"
+                     "  --tolerance      Largest channel difference that still counts as equal (default 0)\n"
+                     "  --max-different  Fraction of the pixels that may differ (default 0)\n"
+                     "  --update         Copies actual renders without a reference to the references\n";
+    }
+
+    /**
+     * Returns the number given as --option=value, or fails if it isn't one
+     * from minimum to maximum, or not a whole one where that is required.
+     */
+    double getNumberForOption (const juce::ArgumentList& args, const juce::String& option, double defaultValue, double minimum, double maximum, bool isWhole)
+    {
+        if (!args.containsOption (option))
+            return defaultValue;
+
+        // ArgumentList only reads the value of a long option after an '='
+        const auto text = args.getValueForOption (option).trim();
+        const auto value = text.getDoubleValue();
+        if (text.isEmpty() || !text.containsOnly (isWhole ? "+-0123456789" : "+-.0123456789eE") || value < minimum || value > maximum)
+        {
+            const auto kind = isWhole ? juce::String (" a whole number from ") : juce::String (" a number from ");
+            juce::ConsoleApplication::fail (option + " needs" + kind + juce::String (minimum, 0) + " to " + juce::String (maximum, 0) + ", as "
+                                                + option + "=<value>, not \"" + text + "\"",
+                                            2);
+        }
+
+        return value;
+    }
+
+    int run (const juce::ArgumentList& args)
+    {
+        if (!args.containsOption ("--reference") || !args.containsOption ("--actual"))
+        {
+            printUsage();
+            return 2;
+        }
+
+        const auto referenceDirectory = args.getFileForOption ("--reference");
+        const auto actualDirectory = args.getExistingFolderForOption ("--actual");
+
+        BogrenDigital::BatchComparer::Options options;
+        options.tolerance = (int) getNumberForOption (args, "--tolerance", 0.0, 0.0, 255.0, true);
+        options.maxDifferentFraction = getNumberForOption (args, "--max-different", 0.0, 0.0, 1.0, false);
+        options.writeMissingReferences = args.containsOption ("--update");
+        if (args.containsOption ("--output"))
+            options.outputDirectory = args.getFileForOption ("--output");
+
+        std::vector<BogrenDigital::BatchComparer::Case> cases;
+        for (const auto& entry : juce::RangedDirectoryIterator (actualDirectory, false, "*.png"))
+        {
+            BogrenDigital::BatchComparer::Case testCase;
+            testCase.name = entry.getFile().getFileNameWithoutExtension();
+            testCase.a = BogrenDigital::BatchComparer::Source::image (entry.getFile());
+            testCase.b = BogrenDigital::BatchComparer::Source::image (referenceDirectory.getChildFile (entry.getFile().getFileName()));
+            cases.push_back (std::move (testCase));
+        }
+
+        std::sort (cases.begin(), cases.end(), [] (const auto& x, const auto& y) { return x.name < y.name; });
+
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+        const auto results = BogrenDigital::BatchComparer::run (cases, options);
+
+        auto numFailed = 0;
+        for (const auto& result : results)
+        {
+            if (result.referenceWritten)
+            {
+                std::cout << "NEW   " << result.name << "\n";
+                continue;
+            }
+
+            numFailed += result.passed ? 0 : 1;
+            std::cout << (result.passed ? "PASS  " : "FAIL  ") << result.name;
+
+            if (result.error.isNotEmpty())
+                std::cout << "  " << result.error;
+            else if (result.metrics)
+                std::cout << "  " << result.differentPixels << " px differ, PSNR " << juce::String (result.metrics->psnr, 2)
+                          << " dB, SSIM " << juce::String (result.metrics->ssim, 4);
+
+            if (result.diffImage != juce::File())
+                std::cout << "  " << result.diffImage.getFullPathName();
+
+            std::cout << "\n";
+        }
+
+        std::cout << results.size() - (size_t) numFailed << " of " << results.size() << " passed in "
+                  << juce::String ((juce::Time::getMillisecondCounterHiRes() - startTime) / 1000.0, 2) << " s\n";
+
+        return numFailed > 0 ? 1 : 0;
+    }
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+    const juce::ArgumentList args (argc, argv);
+
+    // Missing or malformed options fail with a message and exit code rather than an uncaught exception
+    return juce::ConsoleApplication::invokeCatchingFailures ([&args] { return run (args); });
+}
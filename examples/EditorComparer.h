@@ -8,6 +8,7 @@
 
 #include <bd_splitview/bd_splitview.h>
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "ABAudioSwitch.h"
 
 namespace BogrenDigital
 {
@@ -20,10 +21,22 @@ namespace BogrenDigital
             addAndMakeVisible (comparer);
             comparer.setDisplayedComponent (leftEditor.get(), true);
             comparer.setDisplayedComponent (rightEditor.get(), false);
+            comparer.onActiveComponentChanged = [this] (int) { updateAudioSwitch(); };
 
             setEditorConstraints();
         }
 
+        /**
+         * @brief Makes the A and B buttons, and in Split mode the side under
+         * the mouse, select what is heard. The processor owns the switch and
+         * runs both of its processors through ABAudioSwitch::process().
+         */
+        void setAudioSwitch (ABAudioSwitch* switchToControl)
+        {
+            audioSwitch = switchToControl;
+            updateAudioSwitch();
+        }
+
         void setAspectRatio (float newAspectRatio)
         {
             if (aspectRatio != newAspectRatio)
@@ -74,10 +87,17 @@ namespace BogrenDigital
     private:
         std::unique_ptr<juce::AudioProcessorEditor> leftEditor, rightEditor;
         SplitView comparer;
+        ABAudioSwitch* audioSwitch = nullptr;
         float aspectRatio = 0.7131687243f;
         float minWidth = 500.0f;
         float maxWidthMultiplier = 2.39f;
 
+        void updateAudioSwitch()
+        {
+            if (audioSwitch != nullptr)
+                audioSwitch->select (comparer.getActiveComponentIndex() == 1 ? ABAudioSwitch::Side::B : ABAudioSwitch::Side::A);
+        }
+
         void setEditorConstraints()
         {
             const auto minWidth = getMinWidth();
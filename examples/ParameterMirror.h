@@ -0,0 +1,186 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+#include <juce_audio_processors/juce_audio_processors.h>
+
+namespace BogrenDigital
+{
+    /**
+     * @brief Keeps the parameters with the same ID in two processors at the
+     * same value, so both sides of a comparison render the same state.
+     * @details A change on either side is stored in its pair's slot together
+     * with the side it came from, and the slot's bit is set in a dirty mask
+     * until it is applied, so a burst of changes to one parameter only applies
+     * the latest value. If both sides of a pair change before it is applied,
+     * the later change wins and is copied to the other side. Setting a bit
+     * is a single atomic or, so changes may come from any number of threads
+     * at once: the message thread, the audio thread, offline renders or host
+     * worker threads. The mask has a bit for every slot, so nothing can
+     * overflow or be dropped. Call applyPendingChanges() at the start of every
+     * processBlock(); it only touches the parameters that changed, and sets
+     * them through setValueNotifyingHost() like host automation, so the
+     * other editor follows as well. The mapping is built once, in the
+     * constructor, so the parameters of both processors must not change
+     * while the mirror exists.
+     */
+    class ParameterMirror
+    {
+    public:
+        ParameterMirror (juce::AudioProcessor& a, juce::AudioProcessor& b)
+            : listeners { { { *this, 0 }, { *this, 1 } } }
+        {
+            std::map<juce::String, juce::AudioProcessorParameter*> parametersOfB;
+            for (auto* parameter : b.getParameters())
+                if (auto* withID = dynamic_cast<juce::HostedAudioProcessorParameter*> (parameter))
+                    parametersOfB[withID->getParameterID()] = parameter;
+
+            // One slot for every parameter that exists on both sides
+            std::vector<std::pair<juce::AudioProcessorParameter*, juce::AudioProcessorParameter*>> pairs;
+            for (auto* parameter : a.getParameters())
+                if (auto* withID = dynamic_cast<juce::HostedAudioProcessorParameter*> (parameter))
+                    if (const auto match = parametersOfB.find (withID->getParameterID()); match != parametersOfB.end())
+                        pairs.emplace_back (parameter, match->second);
+
+            numSlots = (int) pairs.size();
+            slots = std::make_unique<Slot[]> ((size_t) numSlots);
+            numDirtyWords = (numSlots + 63) / 64;
+            dirtyWords = std::make_unique<std::atomic<juce::uint64>[]> ((size_t) numDirtyWords);
+            for (auto i = 0; i < numDirtyWords; ++i)
+                dirtyWords[(size_t) i].store (0);
+
+            slotOfParameter[0].assign ((size_t) a.getParameters().size(), -1);
+            slotOfParameter[1].assign ((size_t) b.getParameters().size(), -1);
+
+            for (size_t i = 0; i < pairs.size(); ++i)
+            {
+                const auto [parameterOfA, parameterOfB] = pairs[i];
+                slots[i].parameters = { parameterOfA, parameterOfB };
+                slotOfParameter[0][(size_t) parameterOfA->getParameterIndex()] = (int) i;
+                slotOfParameter[1][(size_t) parameterOfB->getParameterIndex()] = (int) i;
+
+                parameterOfA->addListener (&listeners[0]);
+                parameterOfB->addListener (&listeners[1]);
+                parameters.push_back (parameterOfA);
+                parameters.push_back (parameterOfB);
+            }
+        }
+
+        ~ParameterMirror()
+        {
+            for (size_t i = 0; i < parameters.size(); ++i)
+                parameters[i]->removeListener (&listeners[i % 2]);
+        }
+
+        /** Returns the number of parameters that exist on both sides. */
+        int getNumMirroredParameters() const { return numSlots; }
+
+        /**
+         * Applies every change made since the last call. Doesn't allocate, but
+         * setting a parameter takes its listener lock and calls its listeners.
+         */
+        void applyPendingChanges() noexcept
+        {
+            // Applying a change notifies the target's listeners, including this, on this thread
+            const juce::ScopedValueSetter<bool> applying (isApplyingOnThisThread(), true);
+
+            for (auto word = 0; word < numDirtyWords; ++word)
+            {
+                // Cleared before the values are read, so a change that comes in now marks its slot again rather than being lost
+                auto bits = dirtyWords[(size_t) word].exchange (0, std::memory_order_acquire);
+                while (bits != 0)
+                {
+                    const auto bit = countTrailingZeros (bits);
+                    bits &= bits - 1;
+
+                    // Only the latest change is applied, so both sides end up at its value
+                    auto& slot = slots[(size_t) (word * 64 + bit)];
+                    const auto change = slot.latestChange.load (std::memory_order_acquire);
+                    const auto value = getValue (change);
+                    auto* target = slot.parameters[(size_t) (1 - getSide (change))];
+                    if (target->getValue() != value)
+                        target->setValueNotifyingHost (value);
+                }
+            }
+        }
+
+    private:
+        struct Slot
+        {
+            std::array<juce::AudioProcessorParameter*, 2> parameters {}; // Of a and b
+            std::atomic<juce::uint64> latestChange { 0 };                // See packChange()
+        };
+
+        struct Listener : public juce::AudioProcessorParameter::Listener
+        {
+            Listener (ParameterMirror& mirror, int sideIndex) : owner (mirror), side (sideIndex) {}
+
+            void parameterValueChanged (int parameterIndex, float newValue) override { owner.markChanged (side, parameterIndex, newValue); }
+            void parameterGestureChanged (int, bool) override {}
+
+            ParameterMirror& owner;
+            const int side;
+        };
+
+        static int countTrailingZeros (juce::uint64 bits) noexcept
+        {
+            auto count = 0;
+            for (; (bits & 1) == 0; bits >>= 1)
+                ++count;
+            return count;
+        }
+
+        // The value and the side it was set on share one atomic, so they can't be torn apart by a change on the other side
+        static juce::uint64 packChange (int side, float value) noexcept
+        {
+            juce::uint32 valueBits;
+            std::memcpy (&valueBits, &value, sizeof (valueBits));
+            return ((juce::uint64) valueBits << 1) | (juce::uint64) side;
+        }
+
+        static float getValue (juce::uint64 change) noexcept
+        {
+            const auto valueBits = (juce::uint32) (change >> 1);
+            float value;
+            std::memcpy (&value, &valueBits, sizeof (value));
+            return value;
+        }
+
+        static int getSide (juce::uint64 change) noexcept { return (int) (change & 1); }
+
+        static bool& isApplyingOnThisThread()
+        {
+            thread_local bool applying = false;
+            return applying;
+        }
+
+        void markChanged (int side, int parameterIndex, float newValue)
+        {
+            const auto& slotIndices = slotOfParameter[(size_t) side];
+            if (isApplyingOnThisThread() || !juce::isPositiveAndBelow (parameterIndex, (int) slotIndices.size()))
+                return;
+
+            const auto slotIndex = slotIndices[(size_t) parameterIndex];
+            if (slotIndex < 0)
+                return;
+
+            // The value goes first, so whoever sees the bit also sees the value
+            slots[(size_t) slotIndex].latestChange.store (packChange (side, newValue), std::memory_order_release);
+            dirtyWords[(size_t) (slotIndex / 64)].fetch_or ((juce::uint64) 1 << (slotIndex % 64), std::memory_order_release);
+        }
+
+        std::array<Listener, 2> listeners;
+        std::vector<juce::AudioProcessorParameter*> parameters; // Alternating between a and b
+        std::array<std::vector<int>, 2> slotOfParameter;
+        std::unique_ptr<Slot[]> slots;
+        int numSlots = 0;
+        std::unique_ptr<std::atomic<juce::uint64>[]> dirtyWords; // One bit per slot
+        int numDirtyWords = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ParameterMirror)
+    };
+} // namespace BogrenDigital
@@ -0,0 +1,488 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#include <complex>
+
+namespace BogrenDigital
+{
+    namespace
+    {
+        using Complex = std::complex<float>;
+
+        // std::complex's operator* and std::abs guard against overflow and infinities, which dominates the cost here
+        inline Complex multiply (Complex a, Complex b) noexcept
+        {
+            return { a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real() };
+        }
+
+        /** An in-place radix-2 FFT of a fixed power-of-two size. */
+        class FFT
+        {
+        public:
+            explicit FFT (int numPoints)
+                : size (numPoints), twiddles ((size_t) numPoints / 2), inverseTwiddles ((size_t) numPoints / 2), reversed ((size_t) numPoints)
+            {
+                jassert (juce::isPowerOfTwo (size));
+
+                for (size_t i = 0; i < twiddles.size(); ++i)
+                {
+                    twiddles[i] = std::polar (1.0f, -juce::MathConstants<float>::twoPi * (float) i / (float) size);
+                    inverseTwiddles[i] = std::conj (twiddles[i]);
+                }
+
+                for (auto i = 0, j = 0; i < size; ++i)
+                {
+                    reversed[(size_t) i] = j;
+
+                    auto bit = size / 2;
+                    for (; (j & bit) != 0; bit /= 2)
+                        j ^= bit;
+                    j |= bit;
+                }
+            }
+
+            /** The inverse isn't normalised. */
+            void perform (Complex* data, bool inverse) const noexcept
+            {
+                for (auto i = 0; i < size; ++i)
+                    if (i < reversed[(size_t) i])
+                        std::swap (data[i], data[reversed[(size_t) i]]);
+
+                const auto& factors = inverse ? inverseTwiddles : twiddles;
+
+                for (auto length = 2; length <= size; length *= 2)
+                {
+                    const auto half = length / 2;
+                    const auto stride = size / length;
+
+                    // Each twiddle is loaded once per pass rather than once per butterfly
+                    for (auto k = 0; k < half; ++k)
+                    {
+                        const auto twiddle = factors[(size_t) (k * stride)];
+
+                        for (auto start = k; start < size; start += length)
+                        {
+                            const auto t = multiply (twiddle, data[start + half]);
+                            data[start + half] = data[start] - t;
+                            data[start] += t;
+                        }
+                    }
+                }
+            }
+
+        private:
+            const int size;
+            std::vector<Complex> twiddles, inverseTwiddles;
+            std::vector<int> reversed;
+        };
+
+        /** A square of n x n values, row by row. */
+        template <typename Value>
+        struct Grid
+        {
+            explicit Grid (int numPerSide) : n (numPerSide), cells ((size_t) (numPerSide * numPerSide)) {}
+
+            Value& at (int x, int y) { return cells[(size_t) (y * n + x)]; }
+            const Value& at (int x, int y) const { return cells[(size_t) (y * n + x)]; }
+
+            int n;
+            std::vector<Value> cells;
+        };
+
+        void transform (Grid<Complex>& grid, const FFT& fft, bool inverse, WorkerPool& pool)
+        {
+            const auto n = grid.n;
+
+            pool.parallelFor (n, 16, [&] (int begin, int end) {
+                for (auto y = begin; y < end; ++y)
+                    fft.perform (&grid.at (0, y), inverse);
+            });
+
+            // Columns are gathered a cache line's worth at a time, rather than one strided element at a time
+            constexpr auto columnsPerBlock = 8;
+            pool.parallelFor (n / columnsPerBlock, 2, [&] (int begin, int end) {
+                std::vector<Complex> columns ((size_t) (n * columnsPerBlock));
+
+                for (auto block = begin; block < end; ++block)
+                {
+                    const auto firstColumn = block * columnsPerBlock;
+
+                    for (auto y = 0; y < n; ++y)
+                        for (auto i = 0; i < columnsPerBlock; ++i)
+                            columns[(size_t) (i * n + y)] = grid.at (firstColumn + i, y);
+
+                    for (auto i = 0; i < columnsPerBlock; ++i)
+                        fft.perform (&columns[(size_t) (i * n)], inverse);
+
+                    for (auto y = 0; y < n; ++y)
+                        for (auto i = 0; i < columnsPerBlock; ++i)
+                            grid.at (firstColumn + i, y) = columns[(size_t) (i * n + y)];
+                }
+            });
+        }
+
+        /**
+         * @brief Separates the spectra of two real grids that were transformed
+         * together, as the real and imaginary parts of one complex grid.
+         * @details The spectrum of a real grid is conjugate symmetric, which
+         * tells the two apart, so one FFT does the work of two.
+         */
+        std::pair<Grid<Complex>, Grid<Complex>> separateSpectra (const Grid<Complex>& packed, WorkerPool& pool)
+        {
+            const auto n = packed.n;
+            std::pair<Grid<Complex>, Grid<Complex>> spectra { Grid<Complex> (n), Grid<Complex> (n) };
+
+            pool.parallelFor (n, 16, [&] (int begin, int end) {
+                for (auto y = begin; y < end; ++y)
+                {
+                    for (auto x = 0; x < n; ++x)
+                    {
+                        const auto z = packed.at (x, y);
+                        const auto mirrored = std::conj (packed.at ((n - x) & (n - 1), (n - y) & (n - 1)));
+                        const auto difference = z - mirrored;
+                        spectra.first.at (x, y) = (z + mirrored) * 0.5f;
+                        spectra.second.at (x, y) = { difference.imag() * 0.5f, -difference.real() * 0.5f };
+                    }
+                }
+            });
+
+            return spectra;
+        }
+
+        inline void setPart (Complex& value, float part, bool imaginary) noexcept
+        {
+            if (imaginary)
+                value.imag (part);
+            else
+                value.real (part);
+        }
+
+        //==============================================================================
+        /** Averages the luma of image over blocks of factor x factor pixels into the top left of the grid. */
+        void reduceToLuma (const juce::Image& image, int factor, Grid<float>& grid, WorkerPool& pool)
+        {
+            const juce::Image::BitmapData data (image, juce::Image::BitmapData::readOnly);
+            const auto width = juce::jmin (grid.n, image.getWidth() / factor);
+            const auto height = juce::jmin (grid.n, image.getHeight() / factor);
+            const auto normalisation = 1.0f / (float) (factor * factor * 255 * 8);
+
+            pool.parallelFor (height, 8, [&] (int begin, int end) {
+                std::vector<juce::uint32> sums ((size_t) width);
+
+                for (auto gridY = begin; gridY < end; ++gridY)
+                {
+                    std::fill (sums.begin(), sums.end(), 0u);
+
+                    for (auto y = gridY * factor; y < (gridY + 1) * factor; ++y)
+                    {
+                        const auto* pixel = reinterpret_cast<const juce::PixelARGB*> (data.getLinePointer (y));
+                        for (auto& sum : sums)
+                            for (auto i = 0; i < factor; ++i, ++pixel)
+                                sum += (juce::uint32) (pixel->getRed() * 2 + pixel->getGreen() * 5 + pixel->getBlue());
+                    }
+
+                    for (auto x = 0; x < width; ++x)
+                        grid.at (x, gridY) = (float) sums[(size_t) x] * normalisation;
+                }
+            });
+        }
+
+        /**
+         * @brief Removes the mean of the width x height area at the top left,
+         * and tapers it to zero at its edges, so the edges of the image don't
+         * correlate more strongly than its contents.
+         * @param imaginary Whether the result goes into the imaginary parts of
+         * dest rather than the real ones. The other parts are left alone.
+         */
+        void window (const Grid<float>& source, int width, int height, Grid<Complex>& dest, bool imaginary, WorkerPool& pool)
+        {
+            // Summed per row and then in order, so the mean doesn't depend on how the rows were split up
+            std::vector<double> rowSums ((size_t) height);
+            pool.parallelFor (height, 32, [&] (int begin, int end) {
+                for (auto y = begin; y < end; ++y)
+                {
+                    auto sum = 0.0;
+                    for (auto x = 0; x < width; ++x)
+                        sum += source.at (x, y);
+
+                    rowSums[(size_t) y] = sum;
+                }
+            });
+
+            const auto sum = std::accumulate (rowSums.begin(), rowSums.end(), 0.0);
+            const auto mean = (float) (sum / juce::jmax (1, width * height));
+            const auto hann = [] (int i, int length) {
+                return 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * ((float) i + 0.5f) / (float) length);
+            };
+
+            std::vector<float> columnWeights ((size_t) width);
+            for (auto x = 0; x < width; ++x)
+                columnWeights[(size_t) x] = hann (x, width);
+
+            pool.parallelFor (height, 16, [&] (int begin, int end) {
+                for (auto y = begin; y < end; ++y)
+                {
+                    const auto rowWeight = hann (y, height);
+                    for (auto x = 0; x < width; ++x)
+                        setPart (dest.at (x, y), (source.at (x, y) - mean) * rowWeight * columnWeights[(size_t) x], imaginary);
+                }
+            });
+        }
+
+        /** Returns source scaled by 1 / scale about centre, sampled bilinearly. */
+        Grid<float> scaleAbout (const Grid<float>& source, int width, int height, juce::Point<float> centre, float scale, WorkerPool& pool)
+        {
+            Grid<float> result (source.n);
+
+            pool.parallelFor (height, 16, [&] (int begin, int end) {
+                for (auto y = begin; y < end; ++y)
+                {
+                    const auto sourceY = juce::jlimit (0.0f, (float) height - 1.001f, centre.y + scale * ((float) y - centre.y));
+                    const auto y0 = (int) sourceY;
+                    const auto fy = sourceY - (float) y0;
+
+                    for (auto x = 0; x < width; ++x)
+                    {
+                        const auto sourceX = juce::jlimit (0.0f, (float) width - 1.001f, centre.x + scale * ((float) x - centre.x));
+                        const auto x0 = (int) sourceX;
+                        const auto fx = sourceX - (float) x0;
+
+                        const auto top = source.at (x0, y0) + fx * (source.at (x0 + 1, y0) - source.at (x0, y0));
+                        const auto bottom = source.at (x0, y0 + 1) + fx * (source.at (x0 + 1, y0 + 1) - source.at (x0, y0 + 1));
+                        result.at (x, y) = top + fy * (bottom - top);
+                    }
+                }
+            });
+
+            return result;
+        }
+
+        //==============================================================================
+        /**
+         * @brief Resamples the magnitude spectrum onto a size x size log-polar
+         * grid, with the angle from 0 to pi down the rows and the log of the
+         * frequency from 1 to n / 2 along the columns, so that scaling the
+         * image shifts the grid sideways. Goes into the real or imaginary
+         * parts of dest, like window().
+         * @details A high-pass emphasis suppresses the lowest frequencies,
+         * which barely move when scaled, and a window along the frequency axis
+         * keeps its ends from correlating.
+         */
+        void toLogPolar (const Grid<Complex>& spectrum, float logBase, Grid<Complex>& dest, bool imaginary, WorkerPool& pool)
+        {
+            const auto size = dest.n;
+            const auto n = spectrum.n;
+
+            Grid<float> magnitudes (n);
+            pool.parallelFor (n, 16, [&] (int begin, int end) {
+                for (auto i = (size_t) (begin * n); i < (size_t) (end * n); ++i)
+                    magnitudes.cells[i] = std::log1p (std::sqrt (std::norm (spectrum.cells[i])));
+            });
+
+            std::vector<float> radii ((size_t) size), tapers ((size_t) size);
+            for (auto column = 0; column < size; ++column)
+            {
+                radii[(size_t) column] = std::exp ((float) column * logBase);
+                tapers[(size_t) column] = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::twoPi * ((float) column + 0.5f) / (float) size);
+            }
+
+            // Negative frequencies wrap around to the end of each row and column
+            const auto magnitudeAt = [&magnitudes, n] (int x, int y) { return magnitudes.at (x & (n - 1), y & (n - 1)); };
+
+            pool.parallelFor (size, 8, [&] (int begin, int end) {
+                for (auto row = begin; row < end; ++row)
+                {
+                    const auto angle = juce::MathConstants<float>::pi * (float) row / (float) size;
+                    const auto cosine = std::cos (angle), sine = std::sin (angle);
+
+                    for (auto column = 0; column < size; ++column)
+                    {
+                        const auto fx = radii[(size_t) column] * cosine, fy = radii[(size_t) column] * sine;
+                        const auto x0 = (int) std::floor (fx), y0 = (int) std::floor (fy);
+                        const auto tx = fx - (float) x0, ty = fy - (float) y0;
+
+                        const auto top = magnitudeAt (x0, y0) + tx * (magnitudeAt (x0 + 1, y0) - magnitudeAt (x0, y0));
+                        const auto bottom = magnitudeAt (x0, y0 + 1) + tx * (magnitudeAt (x0 + 1, y0 + 1) - magnitudeAt (x0, y0 + 1));
+
+                        const auto emphasis = 1.0f - std::cos (juce::MathConstants<float>::pi * fx / (float) n) * std::cos (juce::MathConstants<float>::pi * fy / (float) n);
+                        setPart (dest.at (column, row), (top + ty * (bottom - top)) * emphasis * (2.0f - emphasis) * tapers[(size_t) column], imaginary);
+                    }
+                }
+            });
+        }
+
+        struct Peak
+        {
+            juce::Point<float> position; // Signed, wrapped to [-n / 2, n / 2)
+            float height = 0.0f; // Normalised to 0 to 1
+        };
+
+        /**
+         * @brief Phase-correlates two spectra and returns the shift of b
+         * against a, so that b (x) is a (x - shift).
+         * @param maxRowShift Limits the search to shifts down the rows of up to
+         * this many, or searches every row if negative.
+         */
+        Peak correlate (const Grid<Complex>& spectrumA, const Grid<Complex>& spectrumB, const FFT& fft, WorkerPool& pool, int maxRowShift = -1)
+        {
+            const auto n = spectrumA.n;
+            Grid<Complex> correlation (n);
+
+            // Only the phase difference is kept, which turns the shift into a single sharp peak
+            pool.parallelFor (n, 16, [&] (int begin, int end) {
+                for (auto i = (size_t) (begin * n); i < (size_t) (end * n); ++i)
+                {
+                    const auto crossPower = multiply (spectrumB.cells[i], std::conj (spectrumA.cells[i]));
+                    const auto magnitude = std::sqrt (std::norm (crossPower));
+                    correlation.cells[i] = magnitude > 1.0e-12f ? crossPower * (1.0f / magnitude) : Complex();
+                }
+            });
+
+            transform (correlation, fft, true, pool);
+
+            const auto valueAt = [&correlation, n] (int x, int y) { return correlation.at (x & (n - 1), y & (n - 1)).real(); };
+            const auto rowLimit = maxRowShift < 0 ? n / 2 : maxRowShift;
+
+            auto bestX = 0, bestY = 0;
+            auto best = -std::numeric_limits<float>::max();
+            for (auto y = 0; y < n; ++y)
+            {
+                const auto shiftY = y < n / 2 ? y : y - n;
+                if (std::abs (shiftY) > rowLimit)
+                    continue;
+
+                for (auto x = 0; x < n; ++x)
+                {
+                    if (const auto value = correlation.at (x, y).real(); value > best)
+                    {
+                        best = value;
+                        bestX = x < n / 2 ? x : x - n;
+                        bestY = shiftY;
+                    }
+                }
+            }
+
+            // The peak of a sub-pixel shift spreads over its neighbours in proportion to how close they are
+            const auto refine = [best] (float before, float after) {
+                if (after > before && after > 0.0f)
+                    return after / (after + best);
+                if (before > 0.0f)
+                    return -before / (before + best);
+                return 0.0f;
+            };
+
+            Peak peak;
+            peak.position = { (float) bestX + refine (valueAt (bestX - 1, bestY), valueAt (bestX + 1, bestY)),
+                (float) bestY + refine (valueAt (bestX, bestY - 1), valueAt (bestX, bestY + 1)) };
+            peak.height = juce::jlimit (0.0f, 1.0f, best / (float) (n * n));
+            return peak;
+        }
+    } // namespace
+
+    //==============================================================================
+    std::optional<Alignment> Alignment::estimate (const juce::Image& a, const juce::Image& b, WorkerPool& pool, const std::function<bool()>& shouldCancel)
+    {
+        if (a.isNull() || b.isNull() || a.getBounds() != b.getBounds())
+            return std::nullopt;
+
+        const auto n = gridSize;
+        const auto factor = juce::jmax (1, (juce::jmax (a.getWidth(), a.getHeight()) + n - 1) / n);
+        const auto width = juce::jmin (n, a.getWidth() / factor);
+        const auto height = juce::jmin (n, a.getHeight() / factor);
+        if (width < 8 || height < 8)
+            return std::nullopt;
+
+        Grid<float> lumaA (n), lumaB (n);
+        reduceToLuma (a.convertedToFormat (juce::Image::ARGB), factor, lumaA, pool);
+        reduceToLuma (b.convertedToFormat (juce::Image::ARGB), factor, lumaB, pool);
+
+        const FFT fft (n);
+        Grid<Complex> packed (n);
+        window (lumaA, width, height, packed, false, pool);
+        window (lumaB, width, height, packed, true, pool);
+        transform (packed, fft, false, pool);
+        auto [spectrumA, spectrumB] = separateSpectra (packed, pool);
+
+        if (shouldCancel())
+            return std::nullopt;
+
+        // Scaling b by s shifts its log-polar spectrum by -log (s) sideways; rotation isn't searched
+        const auto logPolarSize = n / 2;
+        const auto logBase = std::log ((float) n / 2.0f) / (float) logPolarSize;
+        const FFT logPolarFFT (logPolarSize);
+        Grid<Complex> logPolar (logPolarSize);
+        toLogPolar (spectrumA, logBase, logPolar, false, pool);
+        toLogPolar (spectrumB, logBase, logPolar, true, pool);
+        transform (logPolar, logPolarFFT, false, pool);
+        const auto logPolarSpectra = separateSpectra (logPolar, pool);
+        const auto scalePeak = correlate (logPolarSpectra.first, logPolarSpectra.second, logPolarFFT, pool, 1);
+
+        if (shouldCancel())
+            return std::nullopt;
+
+        // Scales within half a bin of 1 are more likely noise than a real difference
+        const auto isScaled = std::abs (scalePeak.position.x) >= 0.5f;
+        const auto scale = isScaled ? std::exp (-scalePeak.position.x * logBase) : 1.0f;
+        const juce::Point<float> centre ((float) width / 2.0f, (float) height / 2.0f);
+
+        if (isScaled)
+        {
+            Grid<Complex> scaledB (n);
+            window (scaleAbout (lumaB, width, height, centre, scale, pool), width, height, scaledB, false, pool);
+            transform (scaledB, fft, false, pool);
+            spectrumB = std::move (scaledB);
+        }
+
+        const auto shiftPeak = correlate (spectrumA, spectrumB, fft, pool);
+
+        if (shouldCancel())
+            return std::nullopt;
+
+        // The shift was measured after scaling b back about the centre; undone, b (y) = a ((y - translation) / scale)
+        const auto translation = centre - (centre - shiftPeak.position) * scale;
+
+        Alignment alignment;
+        alignment.scale = 1.0f / scale;
+        alignment.offset = -translation / scale * (float) factor;
+        alignment.confidence = shiftPeak.height;
+        return alignment;
+    }
+
+    //==============================================================================
+    AutoAligner::AutoAligner()
+        : job ([this] { return prepareWork(); },
+               [this] (std::optional<Alignment>&& result) {
+                   if (onFinished)
+                       onFinished (result);
+               })
+    {
+    }
+
+    void AutoAligner::start (const juce::Image& a, const juce::Image& b)
+    {
+        // An estimate for older images would only be replaced straight away
+        job.cancel();
+        pendingImages = std::make_pair (a, b);
+        job.request();
+    }
+
+    void AutoAligner::cancel()
+    {
+        pendingImages.reset();
+        job.cancel();
+    }
+
+    CoalescingJob<std::optional<Alignment>>::Work AutoAligner::prepareWork()
+    {
+        if (!pendingImages)
+            return nullptr;
+
+        return [this, images = *std::exchange (pendingImages, std::nullopt)] (const auto& shouldCancel) {
+            return Alignment::estimate (images.first, images.second, *workerPool, shouldCancel);
+        };
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,84 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief How one render has to be moved to line up with another, such as
+     * an implementation with its mockup.
+     */
+    struct Alignment
+    {
+        float scale = 1.0f; // Applied first, about the top left corner
+        juce::Point<float> offset; // Applied after scaling
+        float confidence = 0.0f; // Height of the correlation peak, from 0 (none) to 1 (identical)
+
+        /** Returns the transform that moves b onto a. */
+        juce::AffineTransform getTransform() const { return juce::AffineTransform::scale (scale).translated (offset); }
+
+        /** Estimates below this are most likely noise. */
+        static constexpr float minimumConfidence = 0.1f;
+
+        /**
+         * @brief Estimates the scale and translation between two equally sized
+         * images, in parallel on the given pool.
+         * @details Both images are reduced to the luma of a gridSize square,
+         * keeping their aspect ratio. The scale is found by phase correlation
+         * of the log-polar magnitude spectra, where scaling becomes a shift,
+         * then b is scaled back and the translation is found by phase
+         * correlation of the two. The result is in the pixels of the images,
+         * with sub-pixel precision at the grid's resolution. Rotation isn't
+         * estimated. A 4K frame takes a few tens of milliseconds.
+         * @param shouldCancel Polled between the steps; once it returns true
+         * the estimate stops and std::nullopt is returned.
+         * @return std::nullopt if the images are empty or differ in size.
+         */
+        static std::optional<Alignment> estimate (const juce::Image& a,
+            const juce::Image& b,
+            WorkerPool& pool,
+            const std::function<bool()>& shouldCancel = [] { return false; });
+
+        static constexpr int gridSize = 512;
+    };
+
+    /**
+     * @brief Runs Alignment::estimate() off the message thread.
+     * @details A request while an estimate is running cancels it, replaces
+     * any earlier pending one, and starts once the running estimate has
+     * stopped. onFinished is called on the message thread with each result
+     * that wasn't superseded. Nothing ever waits for an estimate, except the
+     * destructor.
+     */
+    class AutoAligner
+    {
+    public:
+        AutoAligner();
+
+        /** Estimates how b has to be moved to line up with a. */
+        void start (const juce::Image& a, const juce::Image& b);
+
+        /** Abandons the running estimate, if any, and any pending request. */
+        void cancel();
+
+        bool isRunning() const { return job.isRunning() || pendingImages.has_value(); }
+
+        /** Called with the result, or std::nullopt if the images couldn't be compared. */
+        std::function<void (const std::optional<Alignment>&)> onFinished;
+
+    private:
+        CoalescingJob<std::optional<Alignment>>::Work prepareWork();
+
+        juce::SharedResourcePointer<WorkerPool> workerPool;
+        std::optional<std::pair<juce::Image, juce::Image>> pendingImages;
+        CoalescingJob<std::optional<Alignment>> job;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AutoAligner)
+    };
+
+} // namespace BogrenDigital
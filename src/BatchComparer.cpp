@@ -0,0 +1,249 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+    namespace
+    {
+        juce::Image loadImage (const juce::File& file)
+        {
+            const auto image = juce::ImageFileFormat::loadFrom (file);
+            return image.isValid() ? image.convertedToFormat (juce::Image::ARGB) : image;
+        }
+
+        bool writeImage (const juce::Image& image, const juce::File& file)
+        {
+            file.deleteFile();
+            juce::FileOutputStream stream (file);
+            return stream.openedOk() && juce::PNGImageFormat().writeImageToStream (image, stream);
+        }
+
+        juce::File getImageFile (const BatchComparer::Source& source, const juce::String& variantName)
+        {
+            return source.imageDirectory != juce::File() ? source.imageDirectory.getChildFile (juce::File::createLegalFileName (variantName) + ".png")
+                                                         : source.imageFile;
+        }
+    } // namespace
+
+    //==============================================================================
+    BatchComparer::Source BatchComparer::Source::component (std::function<std::unique_ptr<juce::Component>()> create)
+    {
+        Source source;
+        source.createComponent = std::move (create);
+        return source;
+    }
+
+    BatchComparer::Source BatchComparer::Source::image (const juce::File& file)
+    {
+        Source source;
+        source.imageFile = file;
+        return source;
+    }
+
+    BatchComparer::Source BatchComparer::Source::images (const juce::File& directory)
+    {
+        Source source;
+        source.imageDirectory = directory;
+        return source;
+    }
+
+    //==============================================================================
+    std::vector<BatchComparer::Result> BatchComparer::run (const std::vector<Case>& cases, const Options& options)
+    {
+        // Components can only be created and painted on the message thread
+        JUCE_ASSERT_MESSAGE_THREAD
+
+        struct Variant
+        {
+            const Case* testCase = nullptr;
+            juce::Point<int> size;
+            float scale = 1.0f;
+            juce::String name;
+            juce::String error; // Set if the case can't be run
+        };
+
+        std::vector<Variant> variants;
+        for (const auto& testCase : cases)
+        {
+            // Images have a size and scale of their own
+            if (!testCase.a.createComponent && !testCase.b.createComponent)
+            {
+                variants.push_back ({ &testCase, {}, 1.0f, testCase.name, {} });
+                continue;
+            }
+
+            // Every size and scale would be compared with the same image, and all but one would fail
+            const auto numVariants = juce::jmax ((size_t) 1, testCase.sizes.size()) * testCase.scales.size();
+            const auto hasSingleImage = testCase.a.imageFile != juce::File() || testCase.b.imageFile != juce::File();
+            if (hasSingleImage && numVariants > 1)
+            {
+                variants.push_back ({ &testCase, {}, 1.0f, testCase.name, "An image file can only be compared at one size and scale; use Source::images() for more" });
+                continue;
+            }
+
+            const auto sizes = testCase.sizes.empty() ? std::vector<juce::Point<int>> { {} } : testCase.sizes;
+            for (const auto& size : sizes)
+            {
+                for (const auto scale : testCase.scales)
+                {
+                    const auto sizeName = size.isOrigin() ? juce::String ("native") : juce::String (size.x) + "x" + juce::String (size.y);
+                    variants.push_back ({ &testCase, size, scale, testCase.name + "_" + sizeName + "@" + juce::String (scale) + "x", {} });
+                }
+            }
+        }
+
+        // Jobs may still be signalling after the last result is in
+        struct Progress
+        {
+            std::atomic<int> jobsRunning { 0 };
+            juce::WaitableEvent jobFinished;
+        };
+
+        juce::SharedResourcePointer<WorkerPool> pool;
+        auto progress = std::make_shared<Progress>();
+        const auto maxJobsRunning = pool->getConcurrency() * 2;
+        std::vector<Result> results (variants.size());
+
+        for (size_t i = 0; i < variants.size(); ++i)
+        {
+            const auto& variant = variants[i];
+            auto& result = results[i];
+            result.name = variant.name;
+
+            if (variant.error.isNotEmpty())
+            {
+                result.error = variant.error;
+                continue;
+            }
+
+            const auto renderSource = [&variant] (const Source& source) {
+                if (!source.createComponent)
+                    return juce::Image();
+
+                auto component = source.createComponent();
+                return component != nullptr ? render (*component, variant.size, variant.scale) : juce::Image();
+            };
+
+            // Rendering is the only part that has to happen here
+            auto renderA = renderSource (variant.testCase->a);
+            auto renderB = renderSource (variant.testCase->b);
+
+            // Bounds the memory held by rendered images waiting to be compared
+            while (progress->jobsRunning.load() >= maxJobsRunning)
+                progress->jobFinished.wait (100);
+
+            // Each variant has images of its own, so no two jobs read or write the same file
+            const auto imageFileA = getImageFile (variant.testCase->a, variant.name);
+            const auto imageFileB = getImageFile (variant.testCase->b, variant.name);
+
+            progress->jobsRunning.fetch_add (1);
+            pool->addBackgroundJob ([&result, &variant, &options, &pool, progress, renderA, renderB, imageFileA, imageFileB] {
+                const auto& testCase = *variant.testCase;
+                auto a = renderA.isValid() ? renderA : loadImage (imageFileA);
+                auto b = renderB.isValid() ? renderB : loadImage (imageFileB);
+
+                if (options.writeMissingReferences && !testCase.b.createComponent && !imageFileB.existsAsFile() && a.isValid())
+                {
+                    imageFileB.getParentDirectory().createDirectory();
+                    result.referenceWritten = writeImage (a, imageFileB);
+                    result.passed = result.referenceWritten;
+                    if (!result.passed)
+                        result.error = "Couldn't write " + imageFileB.getFullPathName();
+                }
+                else
+                {
+                    result = compare (result.name, a, b, options, *pool);
+                }
+
+                progress->jobsRunning.fetch_sub (1);
+                progress->jobFinished.signal();
+            });
+        }
+
+        while (progress->jobsRunning.load() > 0)
+            progress->jobFinished.wait (100);
+
+        return results;
+    }
+
+    juce::Image BatchComparer::render (juce::Component& component, juce::Point<int> size, float scale)
+    {
+        if (!size.isOrigin())
+            component.setSize (size.x, size.y);
+
+        if (component.getWidth() <= 0 || component.getHeight() <= 0)
+            return {};
+
+        // Opaque components are snapshotted as RGB, which the kernels don't take
+        return component.createComponentSnapshot (component.getLocalBounds(), true, scale).convertedToFormat (juce::Image::ARGB);
+    }
+
+    BatchComparer::Result BatchComparer::compare (const juce::String& name, const juce::Image& a, const juce::Image& b, const Options& options, WorkerPool& pool)
+    {
+        Result result;
+        result.name = name;
+
+        if (a.isNull() || b.isNull())
+        {
+            result.error = a.isNull() ? "Couldn't render or load a" : "Couldn't render or load b";
+            return result;
+        }
+
+        if (a.getBounds() != b.getBounds())
+        {
+            result.error = "Size mismatch: " + juce::String (a.getWidth()) + "x" + juce::String (a.getHeight())
+                           + " vs " + juce::String (b.getWidth()) + "x" + juce::String (b.getHeight());
+            return result;
+        }
+
+        const auto width = a.getWidth();
+        {
+            const juce::Image::BitmapData dataA (a, juce::Image::BitmapData::readOnly);
+            const juce::Image::BitmapData dataB (b, juce::Image::BitmapData::readOnly);
+            std::atomic<juce::int64> differentPixels { 0 };
+
+            pool.parallelFor (a.getHeight(), 16, [&] (int begin, int end) {
+                std::vector<juce::uint8> levels ((size_t) width);
+                juce::int64 count = 0;
+
+                for (auto y = begin; y < end; ++y)
+                {
+                    PixelKernels::maxChannelDifference (dataA.getLinePointer (y), dataB.getLinePointer (y), levels.data(), width);
+                    for (const auto level : levels)
+                        count += level > options.tolerance ? 1 : 0;
+                }
+
+                differentPixels.fetch_add (count);
+            });
+
+            result.differentPixels = differentPixels.load();
+        }
+
+        result.metrics = DiffMetrics::compute (a, b, pool);
+
+        const auto totalPixels = (double) width * (double) a.getHeight();
+        result.passed = (double) result.differentPixels <= options.maxDifferentFraction * totalPixels;
+
+        if (!result.passed && options.outputDirectory != juce::File())
+        {
+            options.outputDirectory.createDirectory();
+            const auto baseName = juce::File::createLegalFileName (name);
+
+            juce::Image diff (juce::Image::ARGB, width, a.getHeight(), true);
+            PixelKernels::renderDifference (a, b, diff, { a.getBounds() }, { 1, true }, pool);
+
+            const auto diffFile = options.outputDirectory.getChildFile (baseName + "_diff.png");
+            if (writeImage (diff, diffFile))
+                result.diffImage = diffFile;
+
+            writeImage (a, options.outputDirectory.getChildFile (baseName + "_a.png"));
+            writeImage (b, options.outputDirectory.getChildFile (baseName + "_b.png"));
+        }
+
+        return result;
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,91 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Compares pairs of components, or a component and a reference
+     * image, without a window, for golden-image regression tests.
+     * @details Components are created and rendered on the calling thread, which
+     * must be the message thread, through Component::createComponentSnapshot()
+     * at each requested size and scale. Reference images are decoded, and the
+     * renders compared and written out, on background threads while the next
+     * cases render, with each comparison using all cores.
+     */
+    class BatchComparer
+    {
+    public:
+        /**
+         * @brief One side of a comparison: a component created on demand, an
+         * image file, or a directory with one image per size and scale.
+         */
+        struct Source
+        {
+            static Source component (std::function<std::unique_ptr<juce::Component>()> create);
+
+            /** A single image, so it can only be compared at one size and scale. */
+            static Source image (const juce::File& file);
+
+            /** The image of each size and scale is <directory>/<result name>.png, e.g. "editor_600x400@2x.png". */
+            static Source images (const juce::File& directory);
+
+            std::function<std::unique_ptr<juce::Component>()> createComponent;
+            juce::File imageFile;
+            juce::File imageDirectory;
+        };
+
+        struct Case
+        {
+            juce::String name;
+            Source a, b;
+
+            /** Sizes to render components at. Empty means the size they give themselves. */
+            std::vector<juce::Point<int>> sizes;
+            std::vector<float> scales { 1.0f };
+        };
+
+        struct Options
+        {
+            int tolerance = 0; // Largest channel difference that still counts as equal
+            double maxDifferentFraction = 0.0; // Of the pixels, that may differ by more than tolerance
+            juce::File outputDirectory; // Where the renders and diff images of failures go, if set
+            bool writeMissingReferences = false; // Saves the render of a as the image of b if that doesn't exist yet
+        };
+
+        struct Result
+        {
+            juce::String name; // The case name, with the size and scale of components
+            bool passed = false;
+            juce::String error; // Set if the comparison couldn't be made
+            juce::int64 differentPixels = 0; // Pixels that differ by more than the tolerance
+            std::optional<DiffMetrics> metrics;
+            juce::File diffImage; // The heatmap of the differences, for failures with an output directory
+            bool referenceWritten = false; // The reference didn't exist and was written instead of compared
+        };
+
+        /**
+         * @brief Runs every case at every size and scale, and returns the
+         * results in the same order.
+         */
+        static std::vector<Result> run (const std::vector<Case>& cases, const Options& options);
+
+        /**
+         * @brief Renders a component at the given size and physical scale into
+         * an ARGB image.
+         */
+        static juce::Image render (juce::Component& component, juce::Point<int> size, float scale);
+
+        /**
+         * @brief Compares two rendered images and, on failure, writes the diff
+         * image to the output directory. Can be called from any thread.
+         */
+        static Result compare (const juce::String& name, const juce::Image& a, const juce::Image& b, const Options& options, WorkerPool& pool);
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,183 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    ClippedComponentImage::ClippedComponentImage (juce::Component& ownerComponent, const ClipRegion& clipRegion, Mode renderMode, OffscreenBufferPool* bufferPool)
+        : owner (ownerComponent), region (clipRegion), mode (renderMode), pool (bufferPool)
+    {
+        jassert (mode != Mode::Offscreen || pool != nullptr);
+    }
+
+    void ClippedComponentImage::paint (juce::Graphics& g)
+    {
+        if (mode == Mode::Unclipped)
+        {
+            owner.paintEntireComponent (g, false);
+            return;
+        }
+
+        if (mode == Mode::Offscreen)
+        {
+            paintOffscreen (g);
+            return;
+        }
+
+        if (mode == Mode::Snapshot || mode == Mode::CaptureOnly)
+            updateSnapshot (g.getInternalContext().getPhysicalPixelScaleFactor());
+
+        if (mode == Mode::CaptureOnly || region.isEmpty())
+            return;
+
+        juce::Graphics::ScopedSaveState state (g);
+
+        // Nothing of the owner is visible inside the region being repainted
+        if (!region.reduceClipRegion (g))
+            return;
+
+        if (mode == Mode::Direct)
+        {
+            // The region stays put; only the owner moves inside it
+            g.addTransform (contentTransform);
+            owner.paintEntireComponent (g, false);
+            return;
+        }
+
+        const auto compBounds = owner.getLocalBounds();
+        g.setColour (juce::Colours::black.withAlpha (owner.getAlpha()));
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+        g.drawImageTransformed (snapshot,
+            juce::AffineTransform::scale ((float) compBounds.getWidth() / (float) snapshot.getWidth(),
+                (float) compBounds.getHeight() / (float) snapshot.getHeight())
+                .followedBy (contentTransform),
+            false);
+    }
+
+    void ClippedComponentImage::paintOffscreen (juce::Graphics& g)
+    {
+        if (region.isEmpty() || pool == nullptr)
+            return;
+
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        juce::Graphics::ScopedSaveState state (g);
+
+        // Nothing of the owner is visible inside the region being repainted
+        if (!region.reduceClipRegion (g))
+            return;
+
+        const auto compBounds = owner.getLocalBounds();
+        const auto imageBounds = compBounds * scale;
+
+        // Only the pool and this frame use the buffer, so the next frame gets it back
+        auto buffer = pool->acquire (imageBounds.getWidth(), imageBounds.getHeight());
+        {
+            juce::Graphics imageContext (buffer);
+            imageContext.addTransform (juce::AffineTransform::scale (scale));
+            owner.paintEntireComponent (imageContext, true);
+        }
+
+        g.setColour (juce::Colours::black.withAlpha (owner.getAlpha()));
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+        g.drawImageTransformed (buffer,
+            juce::AffineTransform::scale ((float) compBounds.getWidth() / (float) buffer.getWidth(),
+                (float) compBounds.getHeight() / (float) buffer.getHeight())
+                .followedBy (contentTransform),
+            false);
+    }
+
+    void ClippedComponentImage::updateSnapshot (float scale)
+    {
+        const auto compBounds = owner.getLocalBounds();
+        const auto imageBounds = compBounds * scale;
+
+        if (snapshot.isNull() || snapshot.getBounds() != imageBounds)
+        {
+            snapshot = juce::Image (juce::Image::ARGB,
+                juce::jmax (1, imageBounds.getWidth()),
+                juce::jmax (1, imageBounds.getHeight()),
+                true);
+            validArea.clear();
+        }
+
+        if (validArea.containsRectangle (compBounds))
+            return;
+
+        juce::RectangleList<int> invalidArea (compBounds);
+        invalidArea.subtract (validArea);
+
+        // A background reader may still hold on to the previous contents
+        snapshot.duplicateIfShared();
+
+        // Only the regions invalidated since the last paint are re-rendered
+        juce::Graphics imageContext (snapshot);
+        auto& context = imageContext.getInternalContext();
+        context.addTransform (juce::AffineTransform::scale (scale));
+
+        for (const auto& area : validArea)
+            context.excludeClipRectangle (area);
+
+        context.setFill (juce::Colours::transparentBlack);
+        context.fillRect (compBounds, true);
+        context.setFill (juce::Colours::black);
+
+        owner.paintEntireComponent (imageContext, true);
+        validArea = compBounds;
+
+        if (onSnapshotUpdated)
+        {
+            juce::RectangleList<int> updatedArea;
+            for (const auto& area : invalidArea)
+                updatedArea.add ((area.toFloat() * scale).getSmallestIntegerContainer().getIntersection (snapshot.getBounds()));
+
+            onSnapshotUpdated (updatedArea);
+        }
+    }
+
+    bool ClippedComponentImage::invalidateAll()
+    {
+        if (onInvalidated)
+            onInvalidated (owner.getLocalBounds());
+
+        validArea.clear();
+        hasHeldRepaint = hasHeldRepaint || repaintsHeld;
+        repaintTransformed (owner.getLocalBounds());
+        return !repaintsHeld;
+    }
+
+    bool ClippedComponentImage::invalidate (const juce::Rectangle<int>& area)
+    {
+        if (onInvalidated)
+            onInvalidated (area);
+
+        validArea.subtract (area);
+        hasHeldRepaint = hasHeldRepaint || repaintsHeld;
+        repaintTransformed (area);
+        return !repaintsHeld;
+    }
+
+    void ClippedComponentImage::repaintTransformed (const juce::Rectangle<int>& area)
+    {
+        if (repaintsHeld || contentTransform.isIdentity() || mode == Mode::CaptureOnly || mode == Mode::Unclipped)
+            return;
+
+        // The parent only repaints the invalidated area itself, not where it ends up on screen
+        if (auto* parent = owner.getParentComponent())
+            parent->repaint (area.toFloat().transformedBy (contentTransform).getSmallestIntegerContainer().expanded (1) + owner.getPosition());
+    }
+
+    void ClippedComponentImage::releaseResources()
+    {
+        snapshot = juce::Image();
+        validArea.clear();
+    }
+
+    void ClippedComponentImage::updateBounds (const ClipRegion& newRegion)
+    {
+        region = newRegion;
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,105 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief A CachedComponentImage that paints its owner under a reduced clip
+     * region, which may be a rectangle or a pane between angled dividers.
+     * @details Ownership of the instance is passed to the component through
+     * juce::Component::setCachedComponentImage().
+     */
+    class ClippedComponentImage : public juce::CachedComponentImage
+    {
+    public:
+        /**
+         * @brief Enum class that defines how the owner ends up on screen.
+         * @details
+         * - Direct: The owner is painted directly into the destination context,
+         *   so the owner and its children only rasterise the pixels inside the
+         *   clip region.
+         * - Snapshot: The owner is kept in a snapshot image that is only
+         *   re-rendered where the owner or its children have repainted, so
+         *   changing the clip region becomes a pure blit.
+         * - CaptureOnly: The snapshot is kept up to date but nothing is drawn,
+         *   for views that composite the snapshot themselves.
+         * - Offscreen: The whole owner is painted into a buffer from the pool
+         *   without any external clip, which is then drawn clipped, for
+         *   components that misbehave when painted under a reduced clip.
+         * - Unclipped: The owner is painted as if it had no cached image, and
+         *   the region is ignored; only useful for onInvalidated.
+         */
+        enum class Mode { Direct,
+            Snapshot,
+            CaptureOnly,
+            Offscreen,
+            Unclipped };
+
+        /** @param bufferPool Where Offscreen mode takes its buffers from. Required in that mode. */
+        ClippedComponentImage (juce::Component& owner, const ClipRegion& clipRegion, Mode mode = Mode::Direct, OffscreenBufferPool* bufferPool = nullptr);
+
+        void paint (juce::Graphics& g) override;
+        bool invalidateAll() override;
+        bool invalidate (const juce::Rectangle<int>& area) override;
+        void releaseResources() override;
+
+        void updateBounds (const ClipRegion& newRegion);
+
+        /**
+         * @brief Moves where the owner is drawn inside the clip region, e.g. to
+         * line it up with another render. Ignored in CaptureOnly and Unclipped
+         * mode, and the snapshot stays untransformed.
+         */
+        void setContentTransform (const juce::AffineTransform& newTransform) { contentTransform = newTransform; }
+
+        /**
+         * @brief While held, invalidated areas are only recorded, and the
+         * owner's parent isn't asked to repaint. The snapshot catches up the
+         * next time the area under the owner is repainted for another reason.
+         */
+        void setRepaintsHeld (bool shouldHold) { repaintsHeld = shouldHold; }
+
+        /** Returns true if anything was invalidated while held, and clears the flag. */
+        bool takeHeldRepaint() { return std::exchange (hasHeldRepaint, false); }
+
+        /**
+         * @brief Returns the snapshot of the owner at physical pixel scale, or a
+         * null image in Direct mode or before the first paint.
+         */
+        const juce::Image& getSnapshot() const { return snapshot; }
+
+        /**
+         * @brief Called after the snapshot was re-rendered, with the area that
+         * was re-rendered in snapshot pixels.
+         */
+        std::function<void (const juce::RectangleList<int>&)> onSnapshotUpdated;
+
+        /** Called whenever the owner or its children invalidate an area, in the owner's coordinates. */
+        std::function<void (juce::Rectangle<int>)> onInvalidated;
+
+    private:
+        void updateSnapshot (float scale);
+        void paintOffscreen (juce::Graphics& g);
+        void repaintTransformed (const juce::Rectangle<int>& area);
+
+        juce::Component& owner;
+        ClipRegion region;
+        juce::AffineTransform contentTransform;
+
+        const Mode mode;
+        OffscreenBufferPool* pool;
+        juce::Image snapshot;
+        juce::RectangleList<int> validArea;
+        bool repaintsHeld = false;
+        bool hasHeldRepaint = false;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ClippedComponentImage)
+    };
+
+} // namespace BogrenDigital
@@ -4,11 +4,14 @@
 * License           : GNU General Public License v3.0
 /******************************************************************/
 
+// The deprecation is for users of the class; its own definitions aren't
+JUCE_BEGIN_IGNORE_DEPRECATION_WARNINGS
+
 namespace BogrenDigital
 {
 
-    ClippingRegionEffect::ClippingRegionEffect (juce::Rectangle<int> clipBounds)
-        : bounds (clipBounds)
+    ClippingRegionEffect::ClippingRegionEffect (const ClipRegion& clipRegion)
+        : region (clipRegion)
     {
     }
 
@@ -18,20 +21,25 @@ namespace BogrenDigital
         float alpha)
     {
         destContext.saveState();
-        auto scaledBounds = bounds * scaleFactor;
-        destContext.reduceClipRegion (scaledBounds);
+        auto scaledBounds = region.bounds * scaleFactor;
+        region.reduceClipRegion (destContext, scaleFactor);
         destContext.setOpacity (alpha);
-        // For right component, we need to offset the image to align with the full width
+        // For right or lower components, we need to offset the image to align with the full size
         auto drawX = scaledBounds.getX();
         if (drawX > 0) // This means it's the right component
             drawX = 0;
-        destContext.drawImageAt (sourceImage, drawX, scaledBounds.getY());
+        auto drawY = scaledBounds.getY();
+        if (drawY > 0) // This means it's a lower component
+            drawY = 0;
+        destContext.drawImageAt (sourceImage, drawX, drawY);
         destContext.restoreState();
     }
 
-    void ClippingRegionEffect::updateBounds (juce::Rectangle<int> newBounds)
+    void ClippingRegionEffect::updateBounds (const ClipRegion& newRegion)
     {
-        bounds = newBounds;
+        region = newRegion;
     }
 
-} // namespace BogrenDigital
\ No newline at end of file
+} // namespace BogrenDigital
+
+JUCE_END_IGNORE_DEPRECATION_WARNINGS
\ No newline at end of file
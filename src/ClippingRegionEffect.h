@@ -9,20 +9,27 @@
 namespace BogrenDigital
 {
 
-    class ClippingRegionEffect : public juce::ImageEffectFilter
+    /**
+     * @brief An image effect that draws its component clipped to a region.
+     * @details SplitView no longer uses this: RenderingMode::ComponentEffect
+     * now goes through ClippedComponentImage, which paints into a pooled
+     * buffer instead of the full-size image JUCE allocates for every paint
+     * of a component with an effect. Kept for code that applies it itself.
+     */
+    class [[deprecated ("Use ClippedComponentImage with ClippedComponentImage::Mode::Offscreen instead")]] ClippingRegionEffect : public juce::ImageEffectFilter
     {
     public:
-        explicit ClippingRegionEffect (juce::Rectangle<int> clipBounds);
+        explicit ClippingRegionEffect (const ClipRegion& clipRegion);
 
         void applyEffect (juce::Image& sourceImage,
             juce::Graphics& destContext,
             float scaleFactor,
             float alpha) override;
 
-        void updateBounds (juce::Rectangle<int> newBounds);
+        void updateBounds (const ClipRegion& newRegion);
 
     private:
-        juce::Rectangle<int> bounds;
+        ClipRegion region;
     };
 
 } // namespace BogrenDigital
\ No newline at end of file
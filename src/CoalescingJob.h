@@ -0,0 +1,133 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Runs work on the WorkerPool's background threads one run at a
+     * time, and hands each result back on the message thread.
+     * @details Requests made while a run is going only cause a single run
+     * once it has finished, with whatever prepareWork returns then, so a
+     * burst of requests never queues up stale work. A cancelled run is left
+     * to finish, but its result is dropped. Everything except the work itself
+     * happens on the message thread. The destructor waits for the running
+     * work, so declare this after anything the work uses.
+     */
+    template <typename Result>
+    class CoalescingJob : private juce::AsyncUpdater
+    {
+    public:
+        using ShouldCancel = std::function<bool()>;
+
+        /** Runs on a background thread, polling shouldCancel where it can stop early. */
+        using Work = std::function<Result (const ShouldCancel& shouldCancel)>;
+
+        /**
+         * @param prepareWork Called when a run starts, never while another is
+         * running, so it can hand over state that the work then has to itself.
+         * Returns the work to run, or nullptr to skip the run.
+         * @param onFinished Called with the result of each run that wasn't
+         * cancelled.
+         */
+        CoalescingJob (std::function<Work()> prepareWork, std::function<void (Result&&)> onFinished)
+            : prepare (std::move (prepareWork)),
+              finish (std::move (onFinished))
+        {
+        }
+
+        ~CoalescingJob() override
+        {
+            // The work reports back through this object, so it has to be finished first
+            if (runningJob)
+            {
+                runningJob->cancelled = true;
+                runningJob->finished.wait();
+            }
+
+            cancelPendingUpdate();
+        }
+
+        /** Schedules a run, after the running one if there is one. */
+        void request()
+        {
+            pending = true;
+            triggerAsyncUpdate();
+        }
+
+        /** Drops the result of the running work, if any, and any pending request. */
+        void cancel()
+        {
+            pending = false;
+            if (runningJob)
+                runningJob->cancelled = true;
+        }
+
+        bool isRunning() const { return runningJob != nullptr; }
+
+    private:
+        struct Job
+        {
+            Work work;
+            std::atomic<bool> cancelled { false };
+            std::optional<Result> result;
+            juce::WaitableEvent finished { true };
+        };
+
+        void handleAsyncUpdate() override
+        {
+            if (runningJob && runningJobDone)
+            {
+                const auto job = std::move (runningJob);
+                runningJobDone = false;
+
+                if (!job->cancelled && job->result && finish)
+                    finish (std::move (*job->result));
+            }
+
+            if (pending && !runningJob)
+                start();
+        }
+
+        void start()
+        {
+            pending = false;
+
+            auto work = prepare();
+            if (!work)
+                return;
+
+            auto job = std::make_shared<Job>();
+            job->work = std::move (work);
+            runningJob = job;
+            runningJobDone = false;
+
+            workerPool->addBackgroundJob ([this, job] {
+                job->result = job->work ([&job] { return job->cancelled.load(); });
+
+                // Releases what the work holds, such as frames, so their owner can write to them again without a copy
+                job->work = nullptr;
+
+                runningJobDone = true;
+                triggerAsyncUpdate();
+                job->finished.signal();
+            });
+        }
+
+        std::function<Work()> prepare;
+        std::function<void (Result&&)> finish;
+        juce::SharedResourcePointer<WorkerPool> workerPool;
+
+        std::shared_ptr<Job> runningJob;
+        std::atomic<bool> runningJobDone { false };
+        bool pending = false;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CoalescingJob)
+    };
+
+} // namespace BogrenDigital
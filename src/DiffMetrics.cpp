@@ -0,0 +1,220 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    std::optional<DiffMetrics> DiffMetrics::compute (const juce::Image& a,
+        const juce::Image& b,
+        WorkerPool& pool,
+        const std::function<bool()>& shouldCancel)
+    {
+        return DiffMetricsAccumulator().update (a, b, {}, pool, shouldCancel);
+    }
+
+    //==============================================================================
+    std::optional<DiffMetrics> DiffMetricsAccumulator::update (const juce::Image& a,
+        const juce::Image& b,
+        const std::vector<int>& dirtyTiles,
+        WorkerPool& pool,
+        const std::function<bool()>& shouldCancel)
+    {
+        jassert (a.getBounds() == b.getBounds());
+        jassert (a.getFormat() == juce::Image::ARGB && b.getFormat() == juce::Image::ARGB);
+
+        const auto area = a.getBounds().getIntersection (b.getBounds());
+        const TileGrid frameGrid (area.getWidth(), area.getHeight());
+
+        std::vector<int> allTiles;
+        if (!valid || frameGrid != grid)
+        {
+            grid = frameGrid;
+            tiles.assign ((size_t) grid.getNumTiles(), {});
+            allTiles.resize (tiles.size());
+            std::iota (allTiles.begin(), allTiles.end(), 0);
+        }
+
+        const auto& tilesToUpdate = allTiles.empty() ? dirtyTiles : allTiles;
+
+        // Until this update completes, the per-tile statistics are inconsistent
+        valid = false;
+
+        const juce::Image::BitmapData dataA (a, juce::Image::BitmapData::readOnly);
+        const juce::Image::BitmapData dataB (b, juce::Image::BitmapData::readOnly);
+        std::atomic<bool> cancelled { false };
+
+        pool.parallelFor ((int) tilesToUpdate.size(), 1, [&] (int begin, int end) {
+            for (auto i = begin; i < end; ++i)
+            {
+                if (cancelled.load (std::memory_order_relaxed) || shouldCancel())
+                {
+                    cancelled = true;
+                    return;
+                }
+
+                const auto index = tilesToUpdate[(size_t) i];
+                if (juce::isPositiveAndBelow (index, grid.getNumTiles()))
+                    tiles[(size_t) index] = computeTile (dataA, dataB, grid.getTileBounds (index));
+            }
+        });
+
+        if (cancelled)
+            return std::nullopt;
+
+        valid = true;
+
+        DiffMetrics metrics;
+        metrics.totalPixels = (juce::int64) grid.width * grid.height;
+        if (metrics.totalPixels == 0)
+            return metrics;
+
+        juce::uint64 squaredError = 0;
+        double ssimSum = 0.0;
+        juce::int64 ssimWindows = 0;
+
+        for (const auto& tile : tiles)
+        {
+            metrics.changedPixels += tile.changedPixels;
+            metrics.maxChannelDelta = juce::jmax (metrics.maxChannelDelta, tile.maxChannelDelta);
+            squaredError += tile.squaredError;
+            ssimSum += tile.ssimSum;
+            ssimWindows += tile.ssimWindows;
+        }
+
+        metrics.meanSquaredError = (double) squaredError / (double) (metrics.totalPixels * 3);
+        if (metrics.meanSquaredError > 0.0)
+            metrics.psnr = 10.0 * std::log10 (255.0 * 255.0 / metrics.meanSquaredError);
+        if (ssimWindows > 0)
+            metrics.ssim = ssimSum / (double) ssimWindows;
+
+        return metrics;
+    }
+
+    DiffMetricsAccumulator::TileStatistics DiffMetricsAccumulator::computeTile (const juce::Image::BitmapData& a,
+        const juce::Image::BitmapData& b,
+        juce::Rectangle<int> area)
+    {
+        constexpr int window = 8;
+        constexpr double c1 = (0.01 * 255.0) * (0.01 * 255.0);
+        constexpr double c2 = (0.03 * 255.0) * (0.03 * 255.0);
+        static_assert (TileGrid::tileSize % window == 0, "SSIM windows must not straddle tiles");
+
+        const auto width = area.getWidth();
+        const auto height = area.getHeight();
+
+        std::array<juce::uint8, TileGrid::tileSize> deltas;
+        std::array<juce::uint8, TileGrid::tileSize * TileGrid::tileSize> lumaA, lumaB;
+
+        const auto toLuma = [] (const juce::PixelARGB& p) {
+            return (juce::uint8) ((77 * p.getRed() + 150 * p.getGreen() + 29 * p.getBlue()) >> 8);
+        };
+
+        TileStatistics stats;
+
+        for (auto row = 0; row < height; ++row)
+        {
+            const auto* rowA = a.getPixelPointer (area.getX(), area.getY() + row);
+            const auto* rowB = b.getPixelPointer (area.getX(), area.getY() + row);
+
+            PixelKernels::maxChannelDifference (rowA, rowB, deltas.data(), width);
+            for (auto x = 0; x < width; ++x)
+            {
+                stats.changedPixels += deltas[(size_t) x] != 0 ? 1 : 0;
+                stats.maxChannelDelta = juce::jmax (stats.maxChannelDelta, (int) deltas[(size_t) x]);
+            }
+
+            stats.squaredError += PixelKernels::sumSquaredDifference (rowA, rowB, width);
+
+            const auto* pixelsA = reinterpret_cast<const juce::PixelARGB*> (rowA);
+            const auto* pixelsB = reinterpret_cast<const juce::PixelARGB*> (rowB);
+            for (auto x = 0; x < width; ++x)
+            {
+                lumaA[(size_t) (row * TileGrid::tileSize + x)] = toLuma (pixelsA[x]);
+                lumaB[(size_t) (row * TileGrid::tileSize + x)] = toLuma (pixelsB[x]);
+            }
+        }
+
+        // Partial windows at the right and bottom edges of the frame are left out of the SSIM
+        for (auto windowY = 0; windowY + window <= height; windowY += window)
+        {
+            for (auto windowX = 0; windowX + window <= width; windowX += window)
+            {
+                juce::int64 sumA = 0, sumB = 0, sumAA = 0, sumBB = 0, sumAB = 0;
+                for (auto row = windowY; row < windowY + window; ++row)
+                {
+                    const auto* la = lumaA.data() + row * TileGrid::tileSize + windowX;
+                    const auto* lb = lumaB.data() + row * TileGrid::tileSize + windowX;
+                    for (auto x = 0; x < window; ++x)
+                    {
+                        sumA += la[x];
+                        sumB += lb[x];
+                        sumAA += la[x] * la[x];
+                        sumBB += lb[x] * lb[x];
+                        sumAB += la[x] * lb[x];
+                    }
+                }
+
+                constexpr double n = window * window;
+                const auto meanA = (double) sumA / n;
+                const auto meanB = (double) sumB / n;
+                const auto varianceA = (double) sumAA / n - meanA * meanA;
+                const auto varianceB = (double) sumBB / n - meanB * meanB;
+                const auto covariance = (double) sumAB / n - meanA * meanB;
+
+                stats.ssimSum += ((2.0 * meanA * meanB + c1) * (2.0 * covariance + c2))
+                                 / ((meanA * meanA + meanB * meanB + c1) * (varianceA + varianceB + c2));
+                ++stats.ssimWindows;
+            }
+        }
+
+        return stats;
+    }
+
+    //==============================================================================
+    DiffMetricsEngine::DiffMetricsEngine (FrameProvider frameProvider)
+        : provideFrames (std::move (frameProvider)),
+          job ([this] { return prepareWork(); },
+               [this] (std::optional<DiffMetrics>&& result) {
+                   if (!result)
+                       return;
+
+                   latestMetrics = std::move (result);
+                   if (onMetricsUpdated)
+                       onMetricsUpdated (*latestMetrics);
+               })
+    {
+    }
+
+    void DiffMetricsEngine::markDirty()
+    {
+        job.request();
+    }
+
+    void DiffMetricsEngine::cancel()
+    {
+        job.cancel();
+
+        // A cancelled update leaves the accumulator to start over by itself
+        if (!job.isRunning())
+            accumulator.reset();
+    }
+
+    CoalescingJob<std::optional<DiffMetrics>>::Work DiffMetricsEngine::prepareWork()
+    {
+        auto frames = provideFrames();
+        if (frames.a.isNull() || frames.b.isNull() || frames.a.getBounds() != frames.b.getBounds())
+        {
+            // The dirty tiles handed over with these frames are lost
+            accumulator.reset();
+            return nullptr;
+        }
+
+        return [this, frames = std::move (frames)] (const auto& shouldCancel) {
+            return accumulator.update (frames.a, frames.b, frames.dirtyTiles, *workerPool, shouldCancel);
+        };
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,127 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Numbers that describe how far apart two renders are.
+     */
+    struct DiffMetrics
+    {
+        juce::int64 totalPixels = 0;
+        juce::int64 changedPixels = 0; // Pixels where any colour channel differs
+        int maxChannelDelta = 0; // 0 to 255
+        double meanSquaredError = 0.0; // Over the red, green and blue channels
+        double psnr = std::numeric_limits<double>::infinity(); // In dB, infinite for identical images
+        double ssim = 1.0; // Mean SSIM of the luma over 8x8 windows
+
+        /**
+         * @brief Computes the metrics of two equally sized ARGB images, in
+         * parallel on the given pool.
+         * @param shouldCancel Polled regularly; once it returns true the
+         * computation stops and std::nullopt is returned.
+         */
+        static std::optional<DiffMetrics> compute (const juce::Image& a,
+            const juce::Image& b,
+            WorkerPool& pool,
+            const std::function<bool()>& shouldCancel = [] { return false; });
+    };
+
+    /**
+     * @brief Keeps DiffMetrics statistics per tile, so that only the tiles that
+     * changed since the last update have to be recompared.
+     */
+    class DiffMetricsAccumulator
+    {
+    public:
+        /**
+         * @brief Recomputes the statistics of dirtyTiles and returns the metrics
+         * of the whole frame. Every tile is recomputed if the frame size changed
+         * or the previous update was cancelled.
+         * @param shouldCancel Polled regularly; once it returns true the update
+         * stops and std::nullopt is returned.
+         */
+        std::optional<DiffMetrics> update (const juce::Image& a,
+            const juce::Image& b,
+            const std::vector<int>& dirtyTiles,
+            WorkerPool& pool,
+            const std::function<bool()>& shouldCancel);
+
+        /** Forgets all statistics, so the next update recomputes every tile. */
+        void reset() { valid = false; }
+
+    private:
+        struct TileStatistics
+        {
+            juce::int64 changedPixels = 0;
+            int maxChannelDelta = 0;
+            juce::uint64 squaredError = 0;
+            double ssimSum = 0.0;
+            int ssimWindows = 0;
+        };
+
+        static TileStatistics computeTile (const juce::Image::BitmapData& a, const juce::Image::BitmapData& b, juce::Rectangle<int> area);
+
+        TileGrid grid;
+        std::vector<TileStatistics> tiles;
+        bool valid = false;
+    };
+
+    /**
+     * @brief Computes DiffMetrics of a pair of frames off the message thread.
+     * @details Call markDirty() whenever either frame changes. Requests are
+     * coalesced: while a computation is running, further requests only cause a
+     * single rerun with the latest frames once it has finished. Frames are
+     * fetched through frameProvider on the message thread when a computation
+     * starts, together with the tiles that changed since the previous fetch,
+     * and onMetricsUpdated is called on the message thread with each result.
+     * Nothing ever waits for a computation, except the destructor.
+     */
+    class DiffMetricsEngine
+    {
+    public:
+        struct Frames
+        {
+            juce::Image a, b;
+            std::vector<int> dirtyTiles; // Tiles of a TileGrid that changed since the previous fetch
+        };
+
+        using FrameProvider = std::function<Frames()>;
+
+        explicit DiffMetricsEngine (FrameProvider frameProvider);
+
+        /** Schedules a computation with the latest frames. */
+        void markDirty();
+
+        /** Abandons the running computation, if any, and any pending request. */
+        void cancel();
+
+        /** Returns the most recent result, if there is one. */
+        const std::optional<DiffMetrics>& getLatestMetrics() const { return latestMetrics; }
+
+        std::function<void (const DiffMetrics&)> onMetricsUpdated;
+
+    private:
+        CoalescingJob<std::optional<DiffMetrics>>::Work prepareWork();
+
+        FrameProvider provideFrames;
+        juce::SharedResourcePointer<WorkerPool> workerPool;
+
+        // Only ever touched by the running job, or on the message thread while none is running
+        DiffMetricsAccumulator accumulator;
+
+        std::optional<DiffMetrics> latestMetrics;
+
+        // Last, so that the running job is finished before the accumulator goes
+        CoalescingJob<std::optional<DiffMetrics>> job;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DiffMetricsEngine)
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,294 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    namespace
+    {
+        int findRoot (std::vector<int>& parents, int node)
+        {
+            while (parents[(size_t) node] != node)
+            {
+                // Path halving keeps the trees flat without a second pass
+                parents[(size_t) node] = parents[(size_t) parents[(size_t) node]];
+                node = parents[(size_t) node];
+            }
+
+            return node;
+        }
+
+        void unite (std::vector<int>& parents, int first, int second)
+        {
+            first = findRoot (parents, first);
+            second = findRoot (parents, second);
+
+            if (first < second)
+                parents[(size_t) second] = first;
+            else if (second < first)
+                parents[(size_t) first] = second;
+        }
+    } // namespace
+
+    //==============================================================================
+    std::optional<std::vector<DifferenceRegion>> DifferenceRegionLabeller::update (const juce::Image& a,
+        const juce::Image& b,
+        const std::vector<int>& dirtyTiles,
+        WorkerPool& pool,
+        const std::function<bool()>& shouldCancel)
+    {
+        jassert (a.getBounds() == b.getBounds());
+        jassert (a.getFormat() == juce::Image::ARGB && b.getFormat() == juce::Image::ARGB);
+
+        const auto area = a.getBounds().getIntersection (b.getBounds());
+        const TileGrid frameGrid (area.getWidth(), area.getHeight());
+
+        std::vector<int> allTiles;
+        if (!valid || frameGrid != grid)
+        {
+            grid = frameGrid;
+            tiles.assign ((size_t) grid.getNumTiles(), {});
+            allTiles.resize (tiles.size());
+            std::iota (allTiles.begin(), allTiles.end(), 0);
+        }
+
+        const auto& tilesToUpdate = allTiles.empty() ? dirtyTiles : allTiles;
+
+        // Until this update completes, the masks and the regions are inconsistent
+        valid = false;
+
+        const juce::Image::BitmapData dataA (a, juce::Image::BitmapData::readOnly);
+        const juce::Image::BitmapData dataB (b, juce::Image::BitmapData::readOnly);
+        std::atomic<bool> cancelled { false };
+        std::atomic<bool> maskChanged { !allTiles.empty() };
+
+        pool.parallelFor ((int) tilesToUpdate.size(), 1, [&] (int begin, int end) {
+            TileMask mask;
+            for (auto i = begin; i < end; ++i)
+            {
+                if (cancelled.load (std::memory_order_relaxed) || shouldCancel())
+                {
+                    cancelled = true;
+                    return;
+                }
+
+                const auto index = tilesToUpdate[(size_t) i];
+                if (!juce::isPositiveAndBelow (index, grid.getNumTiles()))
+                    continue;
+
+                computeTile (dataA, dataB, grid.getTileBounds (index), mask);
+
+                // A repainted tile that differs just as before leaves the regions as they were
+                auto& stored = tiles[(size_t) index];
+                if (mask.runs != stored.runs || mask.rowEnds != stored.rowEnds)
+                {
+                    std::swap (mask, stored);
+                    maskChanged.store (true, std::memory_order_relaxed);
+                }
+            }
+        });
+
+        if (cancelled)
+            return std::nullopt;
+
+        if (maskChanged)
+        {
+            auto labelled = label (shouldCancel);
+            if (!labelled)
+                return std::nullopt;
+
+            regions = std::move (*labelled);
+        }
+
+        valid = true;
+        return regions;
+    }
+
+    void DifferenceRegionLabeller::computeTile (const juce::Image::BitmapData& a,
+        const juce::Image::BitmapData& b,
+        juce::Rectangle<int> area,
+        TileMask& mask)
+    {
+        const auto width = area.getWidth();
+        std::array<juce::uint8, TileGrid::tileSize> deltas;
+
+        mask.runs.clear();
+        mask.rowEnds.clear();
+
+        for (auto row = 0; row < area.getHeight(); ++row)
+        {
+            const auto* rowA = a.getPixelPointer (area.getX(), area.getY() + row);
+            const auto* rowB = b.getPixelPointer (area.getX(), area.getY() + row);
+
+            if (std::memcmp (rowA, rowB, (size_t) width * sizeof (juce::uint32)) != 0)
+            {
+                PixelKernels::maxChannelDifference (rowA, rowB, deltas.data(), width);
+                for (auto x = 0; x < width;)
+                {
+                    if (deltas[(size_t) x] == 0)
+                    {
+                        ++x;
+                        continue;
+                    }
+
+                    const auto start = x;
+                    while (x < width && deltas[(size_t) x] != 0)
+                        ++x;
+
+                    mask.runs.push_back ({ area.getX() + start, area.getX() + x });
+                }
+            }
+
+            mask.rowEnds.push_back ((int) mask.runs.size());
+        }
+    }
+
+    std::optional<std::vector<DifferenceRegion>> DifferenceRegionLabeller::label (const std::function<bool()>& shouldCancel) const
+    {
+        struct Node
+        {
+            int y;
+            Run run;
+        };
+
+        std::vector<Node> nodes;
+        std::vector<int> parents;
+        std::vector<Run> currentRow;
+        std::vector<int> currentNodes;
+
+        // The rows within reach above the current one, row y at y % mergeDistance
+        std::array<std::vector<Run>, (size_t) mergeDistance> rowsAbove;
+        std::array<std::vector<int>, (size_t) mergeDistance> nodesAbove;
+
+        for (auto y = 0; y < grid.height; ++y)
+        {
+            if (y % TileGrid::tileSize == 0 && shouldCancel())
+                return std::nullopt;
+
+            // The row's runs, from the tiles across it, with runs that meet at a tile edge joined
+            currentRow.clear();
+            const auto tileRow = y / TileGrid::tileSize;
+            const auto rowInTile = (size_t) (y % TileGrid::tileSize);
+            for (auto tileX = 0; tileX < grid.numTilesX; ++tileX)
+            {
+                const auto& mask = tiles[(size_t) (tileRow * grid.numTilesX + tileX)];
+                const auto begin = rowInTile == 0 ? 0 : mask.rowEnds[rowInTile - 1];
+                for (auto i = begin; i < mask.rowEnds[rowInTile]; ++i)
+                {
+                    const auto& run = mask.runs[(size_t) i];
+                    if (!currentRow.empty() && currentRow.back().end == run.start)
+                        currentRow.back().end = run.end;
+                    else
+                        currentRow.push_back (run);
+                }
+            }
+
+            currentNodes.clear();
+            for (size_t i = 0; i < currentRow.size(); ++i)
+            {
+                const auto node = (int) nodes.size();
+                currentNodes.push_back (node);
+                parents.push_back (node);
+                nodes.push_back ({ y, currentRow[i] });
+
+                if (i > 0 && currentRow[i].start - currentRow[i - 1].end < mergeDistance)
+                    unite (parents, currentNodes[i - 1], node);
+            }
+
+            // The rows are sorted, so one sweep per row above finds every run within reach
+            for (auto distance = 1; distance <= mergeDistance && distance <= y; ++distance)
+            {
+                const auto& runs = rowsAbove[(size_t) ((y - distance) % mergeDistance)];
+                const auto& runNodes = nodesAbove[(size_t) ((y - distance) % mergeDistance)];
+
+                size_t first = 0;
+                for (size_t i = 0; i < currentRow.size(); ++i)
+                {
+                    while (first < runs.size() && runs[first].end <= currentRow[i].start - mergeDistance)
+                        ++first;
+
+                    for (auto j = first; j < runs.size() && runs[j].start < currentRow[i].end + mergeDistance; ++j)
+                        unite (parents, runNodes[j], currentNodes[i]);
+                }
+            }
+
+            std::swap (rowsAbove[(size_t) (y % mergeDistance)], currentRow);
+            std::swap (nodesAbove[(size_t) (y % mergeDistance)], currentNodes);
+        }
+
+        std::vector<DifferenceRegion> labelled;
+        std::vector<int> regionOfRoot (nodes.size(), -1);
+        for (auto node = 0; node < (int) nodes.size(); ++node)
+        {
+            const auto root = (size_t) findRoot (parents, node);
+            if (regionOfRoot[root] < 0)
+            {
+                regionOfRoot[root] = (int) labelled.size();
+                labelled.push_back ({});
+            }
+
+            const auto& [y, run] = nodes[(size_t) node];
+            const juce::Rectangle<int> runBounds (run.start, y, run.end - run.start, 1);
+            auto& region = labelled[(size_t) regionOfRoot[root]];
+            region.bounds = region.numPixels == 0 ? runBounds : region.bounds.getUnion (runBounds);
+            region.numPixels += run.end - run.start;
+        }
+
+        std::sort (labelled.begin(), labelled.end(), [] (const auto& first, const auto& second) {
+            if (first.bounds.getY() != second.bounds.getY())
+                return first.bounds.getY() < second.bounds.getY();
+
+            return first.bounds.getX() < second.bounds.getX();
+        });
+
+        return labelled;
+    }
+
+    //==============================================================================
+    DifferenceRegionEngine::DifferenceRegionEngine (FrameProvider frameProvider)
+        : provideFrames (std::move (frameProvider)),
+          job ([this] { return prepareWork(); },
+               [this] (std::optional<std::vector<DifferenceRegion>>&& result) {
+                   if (!result)
+                       return;
+
+                   latestRegions = std::move (*result);
+                   if (onRegionsUpdated)
+                       onRegionsUpdated (latestRegions);
+               })
+    {
+    }
+
+    void DifferenceRegionEngine::markDirty()
+    {
+        job.request();
+    }
+
+    void DifferenceRegionEngine::cancel()
+    {
+        job.cancel();
+
+        // A cancelled update leaves the labeller to start over by itself
+        if (!job.isRunning())
+            labeller.reset();
+    }
+
+    DifferenceRegionEngine::Job::Work DifferenceRegionEngine::prepareWork()
+    {
+        auto frames = provideFrames();
+        if (frames.a.isNull() || frames.b.isNull() || frames.a.getBounds() != frames.b.getBounds())
+        {
+            // The dirty tiles handed over with these frames are lost
+            labeller.reset();
+            return nullptr;
+        }
+
+        return [this, frames = std::move (frames)] (const auto& shouldCancel) {
+            return labeller.update (frames.a, frames.b, frames.dirtyTiles, *workerPool, shouldCancel);
+        };
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,128 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief A connected area where two renders differ.
+     */
+    struct DifferenceRegion
+    {
+        juce::Rectangle<int> bounds;
+        juce::int64 numPixels = 0; // Pixels in the region where any colour channel differs
+    };
+
+    /**
+     * @brief Labels the connected regions where two renders differ, keeping
+     * the difference mask per tile, so that only the tiles that changed since
+     * the last update have to be recompared.
+     * @details The mask is kept as runs of differing pixels per row. Regions
+     * are labelled in one pass over the runs, top to bottom, joining each run
+     * with a union-find to the runs within mergeDistance of it in its own row
+     * and the rows above, so that e.g. a changed word is one region rather
+     * than one per glyph. That is linear in the number of runs and reads them
+     * in memory order, and is skipped altogether when the runs of the updated
+     * tiles didn't change.
+     */
+    class DifferenceRegionLabeller
+    {
+    public:
+        /**
+         * @brief Recompares dirtyTiles and returns the regions of the whole
+         * frame, sorted top to bottom, then left to right. Every tile is
+         * recompared if the frame size changed or the previous update was
+         * cancelled.
+         * @param shouldCancel Polled regularly; once it returns true the update
+         * stops and std::nullopt is returned.
+         */
+        std::optional<std::vector<DifferenceRegion>> update (const juce::Image& a,
+            const juce::Image& b,
+            const std::vector<int>& dirtyTiles,
+            WorkerPool& pool,
+            const std::function<bool()>& shouldCancel);
+
+        /** Forgets all masks, so the next update recompares every tile. */
+        void reset() { valid = false; }
+
+        /**
+         * Differing pixels at most this many pixels apart, both across and
+         * down, are in the same region; 1 would only join touching pixels.
+         */
+        static constexpr int mergeDistance = 4;
+
+    private:
+        // Differing pixels from start up to, but not including, end
+        struct Run
+        {
+            int start, end;
+
+            bool operator== (const Run& other) const { return start == other.start && end == other.end; }
+        };
+
+        struct TileMask
+        {
+            std::vector<Run> runs;
+            std::vector<int> rowEnds; // rowEnds[y] is one past the last run of row y
+        };
+
+        static void computeTile (const juce::Image::BitmapData& a, const juce::Image::BitmapData& b, juce::Rectangle<int> area, TileMask& mask);
+        std::optional<std::vector<DifferenceRegion>> label (const std::function<bool()>& shouldCancel) const;
+
+        TileGrid grid;
+        std::vector<TileMask> tiles;
+        std::vector<DifferenceRegion> regions;
+        bool valid = false;
+    };
+
+    /**
+     * @brief Labels the regions where a pair of frames differ off the message
+     * thread, in the same way as DiffMetricsEngine computes its metrics.
+     * @details Call markDirty() whenever either frame changes. While a
+     * labelling is running, further requests only cause a single rerun with
+     * the latest frames once it has finished. onRegionsUpdated is called on
+     * the message thread with each result, in the pixels of the frames.
+     */
+    class DifferenceRegionEngine
+    {
+    public:
+        using Frames = DiffMetricsEngine::Frames;
+        using FrameProvider = DiffMetricsEngine::FrameProvider;
+
+        explicit DifferenceRegionEngine (FrameProvider frameProvider);
+
+        /** Schedules a labelling with the latest frames. */
+        void markDirty();
+
+        /** Abandons the running labelling, if any, and any pending request. */
+        void cancel();
+
+        const std::vector<DifferenceRegion>& getLatestRegions() const { return latestRegions; }
+
+        std::function<void (const std::vector<DifferenceRegion>&)> onRegionsUpdated;
+
+    private:
+        using Job = CoalescingJob<std::optional<std::vector<DifferenceRegion>>>;
+
+        Job::Work prepareWork();
+
+        FrameProvider provideFrames;
+        juce::SharedResourcePointer<WorkerPool> workerPool;
+
+        // Only ever touched by the running job, or on the message thread while none is running
+        DifferenceRegionLabeller labeller;
+
+        std::vector<DifferenceRegion> latestRegions;
+
+        // Destroyed first, which waits for a labelling that still uses the labeller
+        Job job;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DifferenceRegionEngine)
+    };
+
+} // namespace BogrenDigital
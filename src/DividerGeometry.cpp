@@ -0,0 +1,224 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+    namespace
+    {
+        using Polygon = std::vector<juce::Point<float>>;
+
+        Polygon toPolygon (juce::Rectangle<int> rectangle)
+        {
+            const auto r = rectangle.toFloat();
+            return { r.getTopLeft(), r.getTopRight(), r.getBottomRight(), r.getBottomLeft() };
+        }
+
+        float dot (juce::Point<float> a, juce::Point<float> b)
+        {
+            return a.x * b.x + a.y * b.y;
+        }
+
+        // Keeps the part of a convex polygon where dot (normal, p) >= offset
+        Polygon clipPolygon (const Polygon& polygon, juce::Point<float> normal, float offset)
+        {
+            Polygon result;
+            for (size_t i = 0; i < polygon.size(); ++i)
+            {
+                const auto a = polygon[i];
+                const auto b = polygon[(i + 1) % polygon.size()];
+                const auto da = dot (normal, a) - offset;
+                const auto db = dot (normal, b) - offset;
+
+                if (da >= 0.0f)
+                    result.push_back (a);
+
+                if ((da >= 0.0f) != (db >= 0.0f))
+                    result.push_back (a + (b - a) * (da / (da - db)));
+            }
+
+            return result;
+        }
+
+        juce::Rectangle<float> getBoundingBox (const Polygon& polygon)
+        {
+            if (polygon.empty())
+                return {};
+
+            auto left = polygon.front().x, right = left;
+            auto top = polygon.front().y, bottom = top;
+            for (const auto& p : polygon)
+            {
+                left = juce::jmin (left, p.x);
+                right = juce::jmax (right, p.x);
+                top = juce::jmin (top, p.y);
+                bottom = juce::jmax (bottom, p.y);
+            }
+
+            return juce::Rectangle<float>::leftTopRightBottom (left, top, right, bottom);
+        }
+    } // namespace
+
+    //==============================================================================
+    juce::AffineTransform ClipRegion::Edge::getTransform() const
+    {
+        // Rotates the x axis onto the normal and moves the origin onto the edge
+        return juce::AffineTransform (normal.x, -normal.y, normal.x * offset, normal.y, normal.x, normal.y * offset);
+    }
+
+    bool ClipRegion::reduceClipRegion (juce::Graphics& g, float scale) const
+    {
+        if (!g.reduceClipRegion (bounds * scale))
+            return false;
+
+        if (numEdges == 0)
+            return true;
+
+        jassert (halfPlane != nullptr);
+        for (auto i = 0; i < numEdges; ++i)
+            g.reduceClipRegion (*halfPlane, edges[(size_t) i].getTransform().scaled (scale));
+
+        return !g.isClipEmpty();
+    }
+
+    bool ClipRegion::contains (juce::Point<float> point) const
+    {
+        if (!bounds.toFloat().contains (point))
+            return false;
+
+        for (auto i = 0; i < numEdges; ++i)
+            if (dot (edges[(size_t) i].normal, point) < edges[(size_t) i].offset)
+                return false;
+
+        return true;
+    }
+
+    //==============================================================================
+    void DividerGeometry::setBounds (juce::Rectangle<int> newBounds)
+    {
+        if (bounds == newBounds)
+            return;
+
+        bounds = newBounds;
+
+        // Everything at x >= 0, large enough to cover the bounds wherever an edge is placed
+        const auto extent = (float) (std::abs (bounds.getX()) + std::abs (bounds.getY()) + std::abs (bounds.getRight()) + std::abs (bounds.getBottom()) + 1);
+        auto path = std::make_shared<juce::Path>();
+        path->addRectangle (juce::Rectangle<float> (0.0f, -extent, extent, extent * 2.0f));
+        halfPlane = std::move (path);
+
+        update();
+    }
+
+    void DividerGeometry::setAngle (float degrees)
+    {
+        angle = juce::jlimit (-90.0f, 90.0f, degrees);
+
+        // Exact normals for the axis-aligned cases keep those panes on rectangle clips
+        if (angle == 0.0f)
+            normal = { 1.0f, 0.0f };
+        else if (std::abs (angle) == 90.0f)
+            normal = { 0.0f, angle > 0.0f ? 1.0f : -1.0f };
+        else
+            normal = { std::cos (juce::degreesToRadians (angle)), std::sin (juce::degreesToRadians (angle)) };
+
+        update();
+    }
+
+    void DividerGeometry::update()
+    {
+        const auto corners = toPolygon (bounds);
+        minOffset = maxOffset = dot (normal, corners.front());
+        for (const auto& corner : corners)
+        {
+            minOffset = juce::jmin (minOffset, dot (normal, corner));
+            maxOffset = juce::jmax (maxOffset, dot (normal, corner));
+        }
+    }
+
+    float DividerGeometry::getOffset (float proportion) const
+    {
+        return minOffset + proportion * (maxOffset - minOffset);
+    }
+
+    float DividerGeometry::getProportionAt (juce::Point<float> point) const
+    {
+        const auto range = maxOffset - minOffset;
+        return range > 0.0f ? (dot (normal, point) - minOffset) / range : 0.0f;
+    }
+
+    ClipRegion DividerGeometry::getRegion (std::optional<float> lowerOffset, std::optional<float> upperOffset) const
+    {
+        if (isAxisAligned())
+        {
+            // The pane covers coordinates c along the axis with lower <= sign * c <= upper
+            const auto dividersAreVertical = normal.y == 0.0f;
+            const auto sign = dividersAreVertical ? normal.x : normal.y;
+            auto from = lowerOffset ? *lowerOffset * sign : -std::numeric_limits<float>::infinity();
+            auto to = upperOffset ? *upperOffset * sign : std::numeric_limits<float>::infinity();
+            if (sign < 0.0f)
+                std::swap (from, to);
+
+            const auto start = dividersAreVertical ? bounds.getX() : bounds.getY();
+            const auto end = dividersAreVertical ? bounds.getRight() : bounds.getBottom();
+            const auto first = std::isfinite (from) ? juce::jlimit (start, end, (int) std::floor (from)) : start;
+            const auto last = std::isfinite (to) ? juce::jlimit (first, end, (int) std::floor (to)) : end;
+
+            return dividersAreVertical ? bounds.withLeft (first).withRight (last)
+                                       : bounds.withTop (first).withBottom (last);
+        }
+
+        ClipRegion region;
+        region.halfPlane = halfPlane;
+
+        auto polygon = toPolygon (bounds);
+        if (lowerOffset)
+        {
+            region.edges[(size_t) region.numEdges++] = { normal, *lowerOffset };
+            polygon = clipPolygon (polygon, normal, *lowerOffset);
+        }
+
+        if (upperOffset)
+        {
+            region.edges[(size_t) region.numEdges++] = { -normal, -*upperOffset };
+            polygon = clipPolygon (polygon, -normal, -*upperOffset);
+        }
+
+        const auto box = getBoundingBox (polygon);
+        region.bounds = box.getWidth() > 0.0f && box.getHeight() > 0.0f
+                            ? box.getSmallestIntegerContainer().getIntersection (bounds)
+                            : juce::Rectangle<int>();
+        return region;
+    }
+
+    juce::Line<float> DividerGeometry::getDividerLine (float offset) const
+    {
+        // The vertices of the clipped bounds that lie on the divider are its ends
+        const auto tangent = juce::Point<float> (-normal.y, normal.x);
+        const auto polygon = clipPolygon (toPolygon (bounds), normal, offset);
+
+        std::optional<juce::Point<float>> first, last;
+        for (const auto& p : polygon)
+        {
+            if (std::abs (dot (normal, p) - offset) > 0.01f)
+                continue;
+
+            if (!first || dot (tangent, p) < dot (tangent, *first))
+                first = p;
+            if (!last || dot (tangent, p) > dot (tangent, *last))
+                last = p;
+        }
+
+        if (!first)
+        {
+            const auto centre = bounds.toFloat().getCentre();
+            const auto onLine = centre + normal * (offset - dot (normal, centre));
+            return { onLine, onLine };
+        }
+
+        return { *first, *last };
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,105 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief The part of a component that one pane of the SplitView shows.
+     * @details Panes between axis-aligned dividers are a plain rectangle, which
+     * graphics contexts clip to cheaply. Panes next to angled dividers are
+     * narrowed further by up to two half-planes. All half-planes share one
+     * cached path, so moving a divider only changes a transform.
+     */
+    struct ClipRegion
+    {
+        ClipRegion() = default;
+        ClipRegion (juce::Rectangle<int> rectangle) : bounds (rectangle) {}
+
+        /** The half-plane of points p with normal.dot (p) >= offset. */
+        struct Edge
+        {
+            juce::Point<float> normal;
+            float offset = 0.0f;
+
+            /** Maps the cached half-plane path (x >= 0) onto this edge. */
+            juce::AffineTransform getTransform() const;
+        };
+
+        bool isEmpty() const { return bounds.isEmpty(); }
+        bool isRectangle() const { return numEdges == 0; }
+
+        /**
+         * @brief Reduces the clip region of g to this region, given in g's
+         * coordinate space divided by scale.
+         * @return false if nothing is left to paint.
+         */
+        bool reduceClipRegion (juce::Graphics& g, float scale = 1.0f) const;
+
+        bool contains (juce::Point<float> point) const;
+
+        juce::Rectangle<int> bounds; // The region itself, or its bounding box if it has edges
+        std::shared_ptr<const juce::Path> halfPlane;
+        std::array<Edge, 2> edges;
+        int numEdges = 0;
+    };
+
+    /**
+     * @brief Maps the divider positions of a SplitView to lines across its
+     * bounds, for any divider angle.
+     * @details Divider positions are proportions of the extent of the bounds
+     * along the divider normal, so they keep their meaning when the angle
+     * changes. The half-plane path used to clip angled panes is only rebuilt
+     * when the size changes.
+     */
+    class DividerGeometry
+    {
+    public:
+        DividerGeometry() = default;
+
+        void setBounds (juce::Rectangle<int> newBounds);
+
+        /**
+         * @brief Sets the angle of the dividers, clockwise from vertical.
+         * @param degrees -90 to 90. 0 puts the panes side by side, 90 stacks
+         * them from top to bottom.
+         */
+        void setAngle (float degrees);
+        float getAngle() const { return angle; }
+
+        bool isAxisAligned() const { return normal.x == 0.0f || normal.y == 0.0f; }
+
+        /** Returns the unit vector across the dividers, pointing towards later panes. */
+        juce::Point<float> getNormal() const { return normal; }
+
+        /** Returns the offset along the normal of the divider at proportion. */
+        float getOffset (float proportion) const;
+
+        /** Returns the divider position that passes through point. */
+        float getProportionAt (juce::Point<float> point) const;
+
+        /**
+         * @brief Returns the region between two divider offsets. Either side
+         * may be left open for the first and last panes.
+         */
+        ClipRegion getRegion (std::optional<float> lowerOffset, std::optional<float> upperOffset) const;
+
+        /** Returns the part of the divider line at offset inside the bounds. */
+        juce::Line<float> getDividerLine (float offset) const;
+
+    private:
+        void update();
+
+        juce::Rectangle<int> bounds;
+        float angle = 0.0f;
+        juce::Point<float> normal { 1.0f, 0.0f };
+        float minOffset = 0.0f, maxOffset = 0.0f;
+        std::shared_ptr<const juce::Path> halfPlane;
+    };
+
+} // namespace BogrenDigital
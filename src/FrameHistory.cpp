@@ -0,0 +1,334 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    // A tile's pixels, run-length encoded, shared by every frame it appears in
+    struct FrameHistory::Tile
+    {
+        Tile (size_t& counter, std::vector<juce::uint32> encodedWords, juce::uint64 tileHash, int tileWidth, int tileHeight)
+            : words (std::move (encodedWords)), hash (tileHash), width (tileWidth), height (tileHeight), storedBytes (counter)
+        {
+            storedBytes += getSize();
+        }
+
+        ~Tile()
+        {
+            storedBytes -= getSize();
+        }
+
+        size_t getSize() const { return sizeof (Tile) + words.size() * sizeof (juce::uint32); }
+
+        const std::vector<juce::uint32> words;
+        const juce::uint64 hash;
+        const int width, height;
+        size_t& storedBytes;
+    };
+
+    namespace
+    {
+        // Each token is followed by one pixel to repeat, or by the given number of literal pixels
+        constexpr juce::uint32 runFlag = 0x80000000;
+        constexpr int minRunLength = 3;
+
+        void encodeRuns (const juce::uint32* pixels, int numPixels, std::vector<juce::uint32>& words)
+        {
+            words.clear();
+
+            auto i = 0;
+            while (i < numPixels)
+            {
+                auto runEnd = i + 1;
+                while (runEnd < numPixels && pixels[runEnd] == pixels[i])
+                    ++runEnd;
+
+                if (runEnd - i >= minRunLength)
+                {
+                    words.push_back (runFlag | (juce::uint32) (runEnd - i));
+                    words.push_back (pixels[i]);
+                    i = runEnd;
+                    continue;
+                }
+
+                // Literals up to where the next run starts
+                const auto start = i;
+                i = runEnd;
+                while (i < numPixels && !(i + 2 < numPixels && pixels[i] == pixels[i + 1] && pixels[i] == pixels[i + 2]))
+                    ++i;
+
+                words.push_back ((juce::uint32) (i - start));
+                words.insert (words.end(), pixels + start, pixels + i);
+            }
+        }
+
+        void decodeRuns (const std::vector<juce::uint32>& words, juce::uint32* pixels)
+        {
+            for (size_t index = 0; index < words.size();)
+            {
+                const auto token = words[index++];
+                const auto count = (size_t) (token & ~runFlag);
+
+                if ((token & runFlag) != 0)
+                {
+                    std::fill_n (pixels, count, words[index++]);
+                }
+                else
+                {
+                    std::copy_n (words.data() + index, count, pixels);
+                    index += count;
+                }
+
+                pixels += count;
+            }
+        }
+
+        void copyTile (const juce::Image::BitmapData& source, juce::Rectangle<int> area, std::vector<juce::uint32>& pixels)
+        {
+            const auto rowBytes = (size_t) area.getWidth() * sizeof (juce::uint32);
+            pixels.resize ((size_t) area.getWidth() * (size_t) area.getHeight());
+            for (auto y = 0; y < area.getHeight(); ++y)
+                std::memcpy (pixels.data() + (size_t) y * (size_t) area.getWidth(), source.getPixelPointer (area.getX(), area.getY() + y), rowBytes);
+        }
+
+        void pasteTile (const std::vector<juce::uint32>& pixels, juce::Rectangle<int> area, const juce::Image::BitmapData& dest)
+        {
+            const auto rowBytes = (size_t) area.getWidth() * sizeof (juce::uint32);
+            for (auto y = 0; y < area.getHeight(); ++y)
+                std::memcpy (dest.getPixelPointer (area.getX(), area.getY() + y), pixels.data() + (size_t) y * (size_t) area.getWidth(), rowBytes);
+        }
+    } // namespace
+
+    //==============================================================================
+    bool FrameHistory::push (const juce::Image& a, const TileHashMap& tilesA, const juce::Image& b, const TileHashMap& tilesB, double time, WorkerPool& pool)
+    {
+        jassert (a.getFormat() == juce::Image::ARGB && b.getFormat() == juce::Image::ARGB);
+
+        const TileGrid frameGrid (a.getWidth(), a.getHeight());
+        if (a.isNull() || a.getBounds() != b.getBounds() || tilesA.getGrid() != frameGrid || tilesB.getGrid() != frameGrid)
+            return false;
+
+        if (frameGrid != grid)
+        {
+            clear();
+            grid = frameGrid;
+        }
+
+        struct EncodedTile
+        {
+            size_t side = 0;
+            int tile = 0;
+            juce::uint64 hash = 0;
+            std::vector<juce::uint32> words {};
+        };
+
+        // The trackers return every tile for the first frame, and after either map was rebuilt
+        std::vector<EncodedTile> encodedTiles;
+        const std::array<const TileHashMap*, 2> maps { &tilesA, &tilesB };
+        for (size_t side = 0; side < 2; ++side)
+            for (auto tile : trackers[side].takeDirtyTiles (*maps[side]))
+                encodedTiles.push_back ({ side, tile });
+
+        if (encodedTiles.empty())
+            return false;
+
+        const std::array<juce::Image::BitmapData, 2> sources { juce::Image::BitmapData (a, juce::Image::BitmapData::readOnly),
+                                                               juce::Image::BitmapData (b, juce::Image::BitmapData::readOnly) };
+
+        pool.parallelFor ((int) encodedTiles.size(), 4, [&] (int begin, int end) {
+            std::vector<juce::uint32> pixels, words;
+            for (auto i = begin; i < end; ++i)
+            {
+                auto& encoded = encodedTiles[(size_t) i];
+                const auto area = grid.getTileBounds (encoded.tile);
+                encoded.hash = TileHashMap::hashArea (sources[encoded.side], area);
+
+                copyTile (sources[encoded.side], area, pixels);
+                encodeRuns (pixels.data(), (int) pixels.size(), words);
+                encoded.words.assign (words.begin(), words.end());
+            }
+        });
+
+        const auto isFirstFrame = frames.empty();
+        if (isFirstFrame)
+            for (auto& tiles : latest)
+                tiles.assign ((size_t) grid.getNumTiles(), nullptr);
+
+        Frame frame;
+        frame.time = time;
+        for (auto& encoded : encodedTiles)
+        {
+            const auto area = grid.getTileBounds (encoded.tile);
+            auto tile = storeTile (encoded.hash, area.getWidth(), area.getHeight(), std::move (encoded.words));
+
+            auto& current = latest[encoded.side][(size_t) encoded.tile];
+            if (tile != current)
+                frame.changes[encoded.side].push_back ({ encoded.tile, current, tile });
+
+            current = std::move (tile);
+        }
+
+        if (isFirstFrame)
+        {
+            base = latest;
+            frame.changes = {};
+        }
+        else if (frame.changes[0].empty() && frame.changes[1].empty())
+        {
+            return false;
+        }
+
+        storedBytes += getChangeBytes (frame);
+        frames.push_back (std::move (frame));
+
+        while (storedBytes > budget && frames.size() > 1)
+            dropOldestFrame();
+
+        return true;
+    }
+
+    FrameHistory::TileRef FrameHistory::storeTile (juce::uint64 hash, int width, int height, std::vector<juce::uint32>&& words)
+    {
+        auto& entry = tilesByHash[hash];
+        if (auto stored = entry.lock())
+            if (stored->width == width && stored->height == height && stored->words.size() == words.size())
+                return stored;
+
+        auto tile = std::make_shared<const Tile> (storedBytes, std::move (words), hash, width, height);
+        entry = tile;
+
+        // Entries of freed tiles are swept out whenever the map has doubled
+        if (tilesByHash.size() > 2 * tilesByHashPruneSize + 256)
+        {
+            for (auto it = tilesByHash.begin(); it != tilesByHash.end();)
+                it = it->second.expired() ? tilesByHash.erase (it) : std::next (it);
+
+            tilesByHashPruneSize = tilesByHash.size();
+        }
+
+        return tile;
+    }
+
+    void FrameHistory::dropOldestFrame()
+    {
+        frames.pop_front();
+
+        // The new oldest frame's changes move into the base, which frees the tiles only they used
+        auto& oldest = frames.front();
+        for (size_t side = 0; side < 2; ++side)
+            for (const auto& change : oldest.changes[side])
+                base[side][(size_t) change.tile] = change.after;
+
+        storedBytes -= getChangeBytes (oldest);
+        oldest.changes = {};
+
+        if (shownIndex >= 0)
+            --shownIndex;
+    }
+
+    size_t FrameHistory::getChangeBytes (const Frame& frame) const
+    {
+        return (frame.changes[0].size() + frame.changes[1].size()) * sizeof (Change);
+    }
+
+    void FrameHistory::clear()
+    {
+        for (const auto& frame : frames)
+            storedBytes -= getChangeBytes (frame);
+
+        frames.clear();
+        base = {};
+        latest = {};
+        for (auto& tracker : trackers)
+            tracker.reset();
+
+        tilesByHash.clear();
+        tilesByHashPruneSize = 0;
+
+        decoded = {};
+        shown = {};
+        drawn = {};
+        shownIndex = -1;
+        grid = {};
+
+        jassert (storedBytes == 0);
+    }
+
+    void FrameHistory::setMemoryBudget (size_t bytes)
+    {
+        budget = bytes;
+        while (storedBytes > budget && frames.size() > 1)
+            dropOldestFrame();
+    }
+
+    //==============================================================================
+    std::vector<int> FrameHistory::decode (int index, WorkerPool& pool)
+    {
+        std::vector<int> changedTiles;
+        if (!juce::isPositiveAndBelow (index, getNumFrames()))
+        {
+            jassertfalse;
+            return changedTiles;
+        }
+
+        const auto numTiles = grid.getNumTiles();
+        if (decoded[0].getWidth() != grid.width || decoded[0].getHeight() != grid.height)
+        {
+            for (auto& image : decoded)
+                image = juce::Image (juce::Image::ARGB, grid.width, grid.height, true);
+
+            for (auto& tiles : drawn)
+                tiles.assign ((size_t) numTiles, nullptr);
+        }
+
+        // Walking from the oldest frame is shorter when it's closer than the one shown
+        if (shownIndex < 0 || index < std::abs (shownIndex - index))
+        {
+            shown = base;
+            shownIndex = 0;
+        }
+
+        for (; shownIndex < index; ++shownIndex)
+            for (size_t side = 0; side < 2; ++side)
+                for (const auto& change : frames[(size_t) shownIndex + 1].changes[side])
+                    shown[side][(size_t) change.tile] = change.after;
+
+        for (; shownIndex > index; --shownIndex)
+            for (size_t side = 0; side < 2; ++side)
+                for (const auto& change : frames[(size_t) shownIndex].changes[side])
+                    shown[side][(size_t) change.tile] = change.before;
+
+        for (auto tile = 0; tile < numTiles; ++tile)
+            if (shown[0][(size_t) tile] != drawn[0][(size_t) tile] || shown[1][(size_t) tile] != drawn[1][(size_t) tile])
+                changedTiles.push_back (tile);
+
+        const std::array<juce::Image::BitmapData, 2> dests { juce::Image::BitmapData (decoded[0], juce::Image::BitmapData::writeOnly),
+                                                             juce::Image::BitmapData (decoded[1], juce::Image::BitmapData::writeOnly) };
+
+        pool.parallelFor ((int) changedTiles.size(), 4, [&] (int begin, int end) {
+            std::vector<juce::uint32> pixels;
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto tile = (size_t) changedTiles[(size_t) i];
+                const auto area = grid.getTileBounds ((int) tile);
+                pixels.resize ((size_t) area.getWidth() * (size_t) area.getHeight());
+
+                for (size_t side = 0; side < 2; ++side)
+                {
+                    if (shown[side][tile] == drawn[side][tile])
+                        continue;
+
+                    decodeRuns (shown[side][tile]->words, pixels.data());
+                    pasteTile (pixels, area, dests[side]);
+                }
+            }
+        });
+
+        drawn = shown;
+        return changedTiles;
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,117 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+#include <deque>
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Keeps a rolling history of frames of two compared components,
+     * for stepping back to transient glitches.
+     * @details Each frame only stores the tiles of a TileGrid that changed
+     * since the frame before, as told by the TileHashMaps of the sides, and
+     * shares the rest with it. Stored tiles are run-length encoded, which
+     * shrinks the flat areas typical of UIs, and a tile that is identical to
+     * one still stored, such as a caret blinking back, is shared instead of
+     * stored again. The oldest frames are dropped once the tiles exceed the
+     * memory budget.
+     *
+     * Each change records the tile before and after it, so decoding a frame
+     * walks the changes from the frame decoded last, in either direction,
+     * and only the tiles that differ from the decoded images are decoded
+     * again. Stepping by a frame costs about as much as that frame's changes.
+     */
+    class FrameHistory
+    {
+    public:
+        FrameHistory() = default;
+
+        /**
+         * @brief Appends a frame of both sides, if any of their tiles changed
+         * since the last frame appended.
+         * @details a and b must be the same size. A size that differs from
+         * the previous frames' clears the history first.
+         * @param time The time of the frame in seconds, e.g. from
+         * juce::Time::getMillisecondCounterHiRes() / 1000.
+         * @return false if nothing changed, so no frame was appended.
+         */
+        bool push (const juce::Image& a, const TileHashMap& tilesA, const juce::Image& b, const TileHashMap& tilesB, double time, WorkerPool& pool);
+
+        /** Drops every frame and the decoded images. */
+        void clear();
+
+        int getNumFrames() const { return (int) frames.size(); }
+        double getFrameTime (int index) const { return frames[(size_t) index].time; }
+
+        /**
+         * @brief Decodes the frame at index, counted from the oldest, into
+         * the images returned by getDecodedFrame().
+         * @return The tiles that changed in either image, all of them after
+         * the images were recreated.
+         */
+        std::vector<int> decode (int index, WorkerPool& pool);
+
+        /** Returns the decoded image of a or b, which is null before the first decode(). */
+        const juce::Image& getDecodedFrame (bool first) const { return decoded[first ? 0 : 1]; }
+
+        const TileGrid& getGrid() const { return grid; }
+
+        /**
+         * @brief Sets how many bytes the stored tiles may take, the decoded
+         * images not included. Default is defaultBudget.
+         */
+        void setMemoryBudget (size_t bytes);
+        size_t getMemoryBudget() const { return budget; }
+        size_t getMemoryUsage() const { return storedBytes; }
+
+        static constexpr size_t defaultBudget = 64 * 1024 * 1024;
+
+    private:
+        struct Tile;
+        using TileRef = std::shared_ptr<const Tile>;
+
+        struct Change
+        {
+            int tile;
+            TileRef before, after;
+        };
+
+        struct Frame
+        {
+            double time = 0.0;
+            std::array<std::vector<Change>, 2> changes; // Empty for the oldest frame, which base holds
+        };
+
+        using TileState = std::array<std::vector<TileRef>, 2>;
+
+        TileRef storeTile (juce::uint64 hash, int width, int height, std::vector<juce::uint32>&& words);
+        void dropOldestFrame();
+        size_t getChangeBytes (const Frame& frame) const;
+
+        size_t storedBytes = 0; // First, as the tiles count themselves out of it when freed
+        size_t budget = defaultBudget;
+
+        TileGrid grid;
+        std::deque<Frame> frames;
+        TileState base; // The tiles of the oldest frame
+        TileState latest; // The tiles of the newest frame
+        std::array<TileHashMap::DirtyTracker, 2> trackers;
+
+        std::unordered_map<juce::uint64, std::weak_ptr<const Tile>> tilesByHash;
+        size_t tilesByHashPruneSize = 0;
+
+        std::array<juce::Image, 2> decoded;
+        TileState shown; // The tiles of the frame at shownIndex
+        TileState drawn; // The tiles in the decoded images
+        int shownIndex = -1; // Invalid until decoded, or once that frame is dropped
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrameHistory)
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,238 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    FrameRecorder::FrameRecorder()
+        : juce::Thread ("SplitView frame encoder")
+    {
+    }
+
+    FrameRecorder::~FrameRecorder()
+    {
+        stop();
+    }
+
+    bool FrameRecorder::start (const juce::File& outputDirectory, Format newFormat, int framesPerSecond, FrameProvider frameProvider)
+    {
+        stop();
+
+        if (!outputDirectory.createDirectory())
+            return false;
+
+        directory = outputDirectory;
+        format = newFormat;
+        provideFrame = std::move (frameProvider);
+        numFramesCaptured = 0;
+        numFramesDropped = 0;
+        numFramesWritten = 0;
+        fifo.reset();
+
+        startThread();
+        startTimerHz (juce::jlimit (1, 120, framesPerSecond));
+        return true;
+    }
+
+    void FrameRecorder::stop()
+    {
+        stopTimer();
+
+        if (isThreadRunning())
+        {
+            // The encoder writes what is queued before it exits
+            signalThreadShouldExit();
+            frameQueued.signal();
+            waitForThreadToExit (-1);
+        }
+    }
+
+    void FrameRecorder::timerCallback()
+    {
+        auto frame = provideFrame();
+        if (frame.isNull())
+            return;
+
+        const auto frameNumber = numFramesCaptured++;
+
+        int start1, size1, start2, size2;
+        fifo.prepareToWrite (1, start1, size1, start2, size2);
+        if (size1 == 0)
+        {
+            // The encoder is behind; waiting for it would stall the UI
+            ++numFramesDropped;
+            return;
+        }
+
+        queuedFrames[(size_t) start1] = std::move (frame);
+        queuedFrameNumbers[(size_t) start1] = frameNumber;
+        fifo.finishedWrite (1);
+        frameQueued.signal();
+    }
+
+    void FrameRecorder::run()
+    {
+        for (;;)
+        {
+            const auto shouldExit = threadShouldExit();
+
+            for (;;)
+            {
+                int start1, size1, start2, size2;
+                fifo.prepareToRead (1, start1, size1, start2, size2);
+                if (size1 == 0)
+                    break;
+
+                writeFrame (queuedFrames[(size_t) start1], queuedFrameNumbers[(size_t) start1]);
+                queuedFrames[(size_t) start1] = {};
+                fifo.finishedRead (1);
+            }
+
+            if (shouldExit)
+                break;
+
+            frameQueued.wait (100);
+        }
+
+        lastFrame = {};
+        lastFile = juce::File();
+    }
+
+    void FrameRecorder::writeFrame (const juce::Image& frame, int frameNumber)
+    {
+        const auto extension = format == Format::PNG ? ".png" : ".qoi";
+        const auto file = directory.getChildFile ("frame_" + juce::String (frameNumber).paddedLeft ('0', 6) + extension);
+
+        auto written = false;
+        if (frame == lastFrame && lastFile.existsAsFile())
+        {
+            // Nothing was repainted since the previous frame
+            written = lastFile.copyFileTo (file);
+        }
+        else
+        {
+            file.deleteFile();
+            juce::FileOutputStream stream (file);
+            written = stream.openedOk()
+                      && (format == Format::PNG ? juce::PNGImageFormat().writeImageToStream (frame, stream)
+                                                : writeQOI (frame, stream));
+        }
+
+        if (written)
+        {
+            lastFrame = frame;
+            lastFile = file;
+            ++numFramesWritten;
+        }
+    }
+
+    bool FrameRecorder::writeQOI (const juce::Image& image, juce::OutputStream& out)
+    {
+        if (image.isNull())
+            return false;
+
+        const auto writeBigEndian = [&out] (juce::uint32 value) {
+            const juce::uint8 bytes[] { (juce::uint8) (value >> 24), (juce::uint8) (value >> 16), (juce::uint8) (value >> 8), (juce::uint8) value };
+            out.write (bytes, sizeof (bytes));
+        };
+
+        out.write ("qoif", 4);
+        writeBigEndian ((juce::uint32) image.getWidth());
+        writeBigEndian ((juce::uint32) image.getHeight());
+        out.writeByte (4); // RGBA
+        out.writeByte (0); // sRGB with linear alpha
+
+        struct Rgba
+        {
+            juce::uint8 r = 0, g = 0, b = 0, a = 255;
+            bool operator== (const Rgba& other) const { return r == other.r && g == other.g && b == other.b && a == other.a; }
+        };
+
+        std::array<Rgba, 64> index {};
+        index.fill ({ 0, 0, 0, 0 });
+        Rgba previous;
+        auto run = 0;
+
+        std::vector<juce::uint8> chunk;
+        chunk.reserve ((size_t) image.getWidth() * 5);
+
+        const juce::Image::BitmapData data (image, juce::Image::BitmapData::readOnly);
+        for (auto y = 0; y < data.height; ++y)
+        {
+            chunk.clear();
+
+            for (auto x = 0; x < data.width; ++x)
+            {
+                // QOI stores straight alpha
+                const auto colour = data.getPixelColour (x, y);
+                const Rgba pixel { colour.getRed(), colour.getGreen(), colour.getBlue(), colour.getAlpha() };
+                const auto isLast = x == data.width - 1 && y == data.height - 1;
+
+                if (pixel == previous)
+                {
+                    if (++run == 62 || isLast)
+                    {
+                        chunk.push_back ((juce::uint8) (0xc0 | (run - 1)));
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run > 0)
+                {
+                    chunk.push_back ((juce::uint8) (0xc0 | (run - 1)));
+                    run = 0;
+                }
+
+                const auto hash = (pixel.r * 3 + pixel.g * 5 + pixel.b * 7 + pixel.a * 11) % 64;
+                if (index[(size_t) hash] == pixel)
+                {
+                    chunk.push_back ((juce::uint8) hash);
+                }
+                else
+                {
+                    index[(size_t) hash] = pixel;
+
+                    if (pixel.a == previous.a)
+                    {
+                        const auto dr = (juce::int8) (pixel.r - previous.r);
+                        const auto dg = (juce::int8) (pixel.g - previous.g);
+                        const auto db = (juce::int8) (pixel.b - previous.b);
+                        const auto drg = dr - dg;
+                        const auto dbg = db - dg;
+
+                        if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+                        {
+                            chunk.push_back ((juce::uint8) (0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2)));
+                        }
+                        else if (drg >= -8 && drg <= 7 && dg >= -32 && dg <= 31 && dbg >= -8 && dbg <= 7)
+                        {
+                            chunk.push_back ((juce::uint8) (0x80 | (dg + 32)));
+                            chunk.push_back ((juce::uint8) ((drg + 8) << 4 | (dbg + 8)));
+                        }
+                        else
+                        {
+                            chunk.insert (chunk.end(), { (juce::uint8) 0xfe, pixel.r, pixel.g, pixel.b });
+                        }
+                    }
+                    else
+                    {
+                        chunk.insert (chunk.end(), { (juce::uint8) 0xff, pixel.r, pixel.g, pixel.b, pixel.a });
+                    }
+                }
+
+                previous = pixel;
+            }
+
+            if (!out.write (chunk.data(), chunk.size()))
+                return false;
+        }
+
+        const juce::uint8 endMarker[] { 0, 0, 0, 0, 0, 0, 0, 1 };
+        return out.write (endMarker, sizeof (endMarker));
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,79 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Captures frames at a fixed rate on the message thread and writes
+     * them to an image sequence on a background thread.
+     * @details Captured frames wait in a small lock-free FIFO. When the encoder
+     * falls behind, new frames are dropped rather than stalling the message
+     * thread. Files are numbered by capture, so drops show up as gaps. A frame
+     * that is the same image as the one before is copied from the previous
+     * file rather than encoded again.
+     */
+    class FrameRecorder : private juce::Thread,
+                          private juce::Timer
+    {
+    public:
+        enum class Format { PNG,
+            QOI };
+
+        /** Returns the frame to record. Called on the message thread. */
+        using FrameProvider = std::function<juce::Image()>;
+
+        FrameRecorder();
+        ~FrameRecorder() override;
+
+        /**
+         * @brief Starts recording into directory, which is created if needed.
+         * @return false if the directory couldn't be created.
+         */
+        bool start (const juce::File& directory, Format format, int framesPerSecond, FrameProvider frameProvider);
+
+        /** Stops capturing, and returns once every queued frame is written. */
+        void stop();
+
+        bool isRecording() const { return isTimerRunning(); }
+
+        int getNumFramesCaptured() const { return numFramesCaptured; }
+        int getNumFramesWritten() const { return numFramesWritten.load(); }
+        int getNumFramesDropped() const { return numFramesDropped; }
+
+        /** Writes an image in the QOI format, https://qoiformat.org. */
+        static bool writeQOI (const juce::Image& image, juce::OutputStream& out);
+
+        static constexpr int capacity = 8;
+
+    private:
+        void timerCallback() override;
+        void run() override;
+        void writeFrame (const juce::Image& frame, int frameNumber);
+
+        FrameProvider provideFrame;
+        juce::File directory;
+        Format format = Format::PNG;
+
+        juce::AbstractFifo fifo { capacity };
+        std::array<juce::Image, capacity> queuedFrames;
+        std::array<int, capacity> queuedFrameNumbers {};
+        juce::WaitableEvent frameQueued;
+
+        int numFramesCaptured = 0;
+        int numFramesDropped = 0;
+        std::atomic<int> numFramesWritten { 0 };
+
+        // Only touched by the encoder thread
+        juce::Image lastFrame;
+        juce::File lastFile;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (FrameRecorder)
+    };
+
+} // namespace BogrenDigital
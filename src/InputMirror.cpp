@@ -0,0 +1,202 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+    namespace
+    {
+        /** Child indices leading from root down to component. */
+        std::vector<int> getChildIndexPath (const juce::Component& root, const juce::Component& component)
+        {
+            std::vector<int> path;
+            for (auto* c = &component; c != &root && c != nullptr; c = c->getParentComponent())
+            {
+                if (auto* parent = c->getParentComponent())
+                    path.push_back (parent->getIndexOfChildComponent (c));
+            }
+
+            std::reverse (path.begin(), path.end());
+            return path;
+        }
+
+        juce::Component* followChildIndexPath (juce::Component& root, const std::vector<int>& path)
+        {
+            auto* component = &root;
+            for (const auto index : path)
+            {
+                component = component->getChildComponent (index);
+                if (component == nullptr)
+                    return nullptr;
+            }
+
+            return component;
+        }
+    } // namespace
+
+    //==============================================================================
+    InputMirror::InputMirror (juce::Component& parent, RootsProvider rootsProvider)
+        : owner (parent), getRoots (std::move (rootsProvider))
+    {
+    }
+
+    InputMirror::~InputMirror()
+    {
+        setEnabled (false);
+    }
+
+    void InputMirror::setEnabled (bool shouldBeEnabled)
+    {
+        if (enabled == shouldBeEnabled)
+            return;
+
+        enabled = shouldBeEnabled;
+        mouseDownTargets.clear();
+
+        if (enabled)
+        {
+            owner.addMouseListener (this, true);
+            juce::Desktop::getInstance().addFocusChangeListener (this);
+            globalFocusChanged (juce::Component::getCurrentlyFocusedComponent());
+        }
+        else
+        {
+            owner.removeMouseListener (this);
+            juce::Desktop::getInstance().removeFocusChangeListener (this);
+            globalFocusChanged (nullptr);
+        }
+    }
+
+    //==============================================================================
+    juce::Component* InputMirror::findRoot (const juce::Component* component) const
+    {
+        if (component == nullptr)
+            return nullptr;
+
+        for (auto* root : getRoots())
+        {
+            if (root != nullptr && (root == component || root->isParentOf (component)))
+                return root;
+        }
+
+        return nullptr;
+    }
+
+    std::vector<InputMirror::Target> InputMirror::findTargetsAt (const juce::MouseEvent& e) const
+    {
+        std::vector<Target> targets;
+        auto* sourceRoot = findRoot (e.originalComponent);
+        if (sourceRoot == nullptr)
+            return targets;
+
+        const auto position = sourceRoot->getLocalPoint (e.eventComponent, e.position).roundToInt();
+        for (auto* root : getRoots())
+        {
+            if (root == nullptr || root == sourceRoot)
+                continue;
+
+            // The roots overlap, so the point is the same relative to each of them
+            if (auto* component = root->getComponentAt (position))
+                targets.push_back ({ root, component });
+        }
+
+        return targets;
+    }
+
+    juce::MouseEvent InputMirror::getMirroredEvent (const juce::MouseEvent& e, const juce::Component& sourceRoot, const Target& target)
+    {
+        const auto position = target.component->getLocalPoint (target.root, sourceRoot.getLocalPoint (e.eventComponent, e.position));
+        return e.getEventRelativeTo (target.component).withNewPosition (position);
+    }
+
+    template <typename Callback>
+    void InputMirror::sendToTargets (const juce::MouseEvent& e, const std::vector<Target>& targets, Callback&& callback)
+    {
+        // Events reach this once per listener; the parent chain may repeat wheel events
+        if (e.eventComponent != e.originalComponent)
+            return;
+
+        auto* sourceRoot = findRoot (e.originalComponent);
+        if (sourceRoot == nullptr)
+            return;
+
+        for (const auto& target : targets)
+        {
+            if (target.root != nullptr && target.component != nullptr)
+                callback (*target.component, getMirroredEvent (e, *sourceRoot, target));
+        }
+    }
+
+    //==============================================================================
+    void InputMirror::mouseMove (const juce::MouseEvent& e)
+    {
+        sendToTargets (e, findTargetsAt (e), [] (juce::Component& c, const juce::MouseEvent& me) { c.mouseMove (me); });
+    }
+
+    void InputMirror::mouseDown (const juce::MouseEvent& e)
+    {
+        mouseDownTargets = findTargetsAt (e);
+        sendToTargets (e, mouseDownTargets, [] (juce::Component& c, const juce::MouseEvent& me) { c.mouseDown (me); });
+    }
+
+    void InputMirror::mouseDrag (const juce::MouseEvent& e)
+    {
+        sendToTargets (e, mouseDownTargets, [] (juce::Component& c, const juce::MouseEvent& me) { c.mouseDrag (me); });
+    }
+
+    void InputMirror::mouseUp (const juce::MouseEvent& e)
+    {
+        sendToTargets (e, mouseDownTargets, [] (juce::Component& c, const juce::MouseEvent& me) { c.mouseUp (me); });
+        mouseDownTargets.clear();
+    }
+
+    void InputMirror::mouseDoubleClick (const juce::MouseEvent& e)
+    {
+        sendToTargets (e, findTargetsAt (e), [] (juce::Component& c, const juce::MouseEvent& me) { c.mouseDoubleClick (me); });
+    }
+
+    void InputMirror::mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+    {
+        sendToTargets (e, findTargetsAt (e), [&wheel] (juce::Component& c, const juce::MouseEvent& me) { c.mouseWheelMove (me, wheel); });
+    }
+
+    //==============================================================================
+    void InputMirror::globalFocusChanged (juce::Component* focusedComponent)
+    {
+        // Key listeners run before the component's own keyPressed, so this sees every key
+        if (keyListenerComponent != nullptr)
+            keyListenerComponent->removeKeyListener (this);
+
+        keyListenerComponent = enabled && findRoot (focusedComponent) != nullptr ? focusedComponent : nullptr;
+
+        if (keyListenerComponent != nullptr)
+            keyListenerComponent->addKeyListener (this);
+    }
+
+    bool InputMirror::keyPressed (const juce::KeyPress& key, juce::Component* originatingComponent)
+    {
+        auto* sourceRoot = findRoot (originatingComponent);
+        if (sourceRoot == nullptr)
+            return false;
+
+        const auto path = getChildIndexPath (*sourceRoot, *originatingComponent);
+        for (auto* root : getRoots())
+        {
+            if (root == nullptr || root == sourceRoot)
+                continue;
+
+            // Bubbles up like a key press on the focused component does, but no further than the root
+            for (auto* target = followChildIndexPath (*root, path); target != nullptr; target = target->getParentComponent())
+            {
+                if (target->keyPressed (key) || target == root)
+                    break;
+            }
+        }
+
+        // The focused component still gets the key as usual
+        return false;
+    }
+
+} // namespace BogrenDigital
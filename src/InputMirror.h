@@ -0,0 +1,77 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Repeats the mouse and keyboard input that one of several
+     * identically laid out component trees receives on the others, so that
+     * their states stay in sync.
+     * @details Mouse events are sent to the component under the same point in
+     * each other tree; drags and mouse-ups go to the components that got the
+     * mouse-down. Key presses are sent to the component at the same child
+     * index path as the focused one, and bubble up its parents until one uses
+     * them. The mirrored calls go straight to the components' callbacks, so
+     * components that query the real mouse state instead of the event, such
+     * as juce::Button, won't follow mirrored clicks.
+     */
+    class InputMirror : private juce::MouseListener,
+                        private juce::KeyListener,
+                        private juce::FocusChangeListener
+    {
+    public:
+        /** Returns the roots of the trees to keep in sync. Called on the message thread. */
+        using RootsProvider = std::function<std::vector<juce::Component*>()>;
+
+        /** Listens to the input of every component inside parent once enabled. */
+        InputMirror (juce::Component& parent, RootsProvider rootsProvider);
+        ~InputMirror() override;
+
+        void setEnabled (bool shouldBeEnabled);
+        bool isEnabled() const { return enabled; }
+
+    private:
+        struct Target
+        {
+            juce::Component::SafePointer<juce::Component> root;
+            juce::Component::SafePointer<juce::Component> component;
+        };
+
+        void mouseMove (const juce::MouseEvent& e) override;
+        void mouseDown (const juce::MouseEvent& e) override;
+        void mouseDrag (const juce::MouseEvent& e) override;
+        void mouseUp (const juce::MouseEvent& e) override;
+        void mouseDoubleClick (const juce::MouseEvent& e) override;
+        void mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+        bool keyPressed (const juce::KeyPress& key, juce::Component* originatingComponent) override;
+        void globalFocusChanged (juce::Component* focusedComponent) override;
+
+        /** Returns the root that contains component, or nullptr. */
+        juce::Component* findRoot (const juce::Component* component) const;
+
+        /** Returns the components under the event's position in every root but the source's. */
+        std::vector<Target> findTargetsAt (const juce::MouseEvent& e) const;
+
+        /** Converts e into an event on target at the same point relative to their roots. */
+        static juce::MouseEvent getMirroredEvent (const juce::MouseEvent& e, const juce::Component& sourceRoot, const Target& target);
+
+        template <typename Callback>
+        void sendToTargets (const juce::MouseEvent& e, const std::vector<Target>& targets, Callback&& callback);
+
+        juce::Component& owner;
+        RootsProvider getRoots;
+        bool enabled = false;
+
+        std::vector<Target> mouseDownTargets;
+        juce::Component::SafePointer<juce::Component> keyListenerComponent;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (InputMirror)
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,70 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    OffscreenBufferPool::OffscreenBufferPool (size_t budgetInBytes)
+        : budget (budgetInBytes)
+    {
+    }
+
+    juce::Image OffscreenBufferPool::acquire (int width, int height)
+    {
+        width = juce::jmax (1, width);
+        height = juce::jmax (1, height);
+
+        for (auto& buffer : buffers)
+        {
+            // The pool's own reference is the only one left once a user is done with it
+            if (buffer.image.getWidth() == width && buffer.image.getHeight() == height && buffer.image.getReferenceCount() == 1)
+            {
+                buffer.lastUsed = ++useCounter;
+                buffer.image.clear (buffer.image.getBounds());
+                return buffer.image;
+            }
+        }
+
+        const auto bytes = getBytes (width, height);
+        trim (budget > bytes ? budget - bytes : 0);
+
+        juce::Image image (juce::Image::ARGB, width, height, true);
+        if (bytesHeld + bytes <= budget)
+        {
+            buffers.push_back ({ image, ++useCounter });
+            bytesHeld += bytes;
+        }
+
+        return image;
+    }
+
+    void OffscreenBufferPool::setBudget (size_t budgetInBytes)
+    {
+        budget = budgetInBytes;
+        trim (budget);
+    }
+
+    void OffscreenBufferPool::trim (size_t limit)
+    {
+        while (bytesHeld > limit)
+        {
+            auto leastRecentlyUsed = buffers.end();
+            for (auto it = buffers.begin(); it != buffers.end(); ++it)
+            {
+                if (it->image.getReferenceCount() == 1 && (leastRecentlyUsed == buffers.end() || it->lastUsed < leastRecentlyUsed->lastUsed))
+                    leastRecentlyUsed = it;
+            }
+
+            // Everything left is in use
+            if (leastRecentlyUsed == buffers.end())
+                return;
+
+            bytesHeld -= getBytes (leastRecentlyUsed->image.getWidth(), leastRecentlyUsed->image.getHeight());
+            buffers.erase (leastRecentlyUsed);
+        }
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,62 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Keeps the offscreen images that are rendered into every frame, so
+     * they are allocated once rather than per paint.
+     * @details Buffers are keyed by their size in physical pixels, which
+     * already includes the display scale. A buffer is free again as soon as
+     * the last copy of the image handed out is gone. The pool holds on to at
+     * most the budget's worth of buffers, dropping the least recently used
+     * free ones first; a buffer that doesn't fit is handed out but not kept.
+     * Only use it on the message thread.
+     */
+    class OffscreenBufferPool
+    {
+    public:
+        static constexpr size_t defaultBudget = 256 * 1024 * 1024;
+
+        explicit OffscreenBufferPool (size_t budgetInBytes = defaultBudget);
+
+        /** Returns a cleared ARGB image of the given size, reusing a free one if possible. */
+        juce::Image acquire (int width, int height);
+
+        /** Sets how many bytes of buffers the pool keeps, and frees free buffers beyond it. */
+        void setBudget (size_t budgetInBytes);
+        size_t getBudget() const { return budget; }
+
+        /** Returns the bytes held by the pool, whether the buffers are in use or not. */
+        size_t getBytesHeld() const { return bytesHeld; }
+
+        /** Frees every buffer that isn't in use. */
+        void releaseUnused() { trim (0); }
+
+    private:
+        struct Buffer
+        {
+            juce::Image image;
+            juce::uint64 lastUsed = 0;
+        };
+
+        static size_t getBytes (int width, int height) { return (size_t) width * (size_t) height * 4; }
+
+        /** Frees free buffers, least recently used first, until at most limit bytes are held. */
+        void trim (size_t limit);
+
+        size_t budget;
+        size_t bytesHeld = 0;
+        juce::uint64 useCounter = 0;
+        std::vector<Buffer> buffers;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OffscreenBufferPool)
+    };
+
+} // namespace BogrenDigital
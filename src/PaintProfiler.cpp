@@ -0,0 +1,135 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+    namespace
+    {
+        double getPercentile (const std::vector<double>& sorted, double percentile)
+        {
+            // Nearest rank
+            const auto rank = (size_t) std::ceil (percentile / 100.0 * (double) sorted.size());
+            return sorted[juce::jlimit ((size_t) 0, sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+        }
+    } // namespace
+
+    //==============================================================================
+    double PaintProfiler::Sample::getDurationMs() const
+    {
+        return juce::Time::highResolutionTicksToSeconds (endTicks - startTicks) * 1000.0;
+    }
+
+    PaintProfiler::PaintProfiler()
+        : ring ((size_t) capacity)
+    {
+    }
+
+    void PaintProfiler::addSample (const Sample& sample) noexcept
+    {
+        const auto index = numWritten.load (std::memory_order_relaxed);
+        ring[(size_t) (index % capacity)] = sample;
+        numWritten.store (index + 1, std::memory_order_release);
+    }
+
+    std::vector<PaintProfiler::Sample> PaintProfiler::getSamples (int maxSamples) const
+    {
+        const auto end = numWritten.load (std::memory_order_acquire);
+        const auto count = juce::jmin (end, (juce::uint64) juce::jlimit (0, capacity, maxSamples));
+        const auto begin = end - count;
+
+        std::vector<Sample> samples;
+        samples.reserve ((size_t) count);
+        for (auto i = begin; i < end; ++i)
+            samples.push_back (ring[(size_t) (i % capacity)]);
+
+        // Slots the writer has started to reuse since may hold a mix of two samples
+        std::atomic_thread_fence (std::memory_order_acquire);
+        const auto written = numWritten.load (std::memory_order_relaxed);
+        const auto firstValid = written >= (juce::uint64) capacity ? written - (juce::uint64) capacity + 1 : 0;
+        if (firstValid > begin)
+            samples.erase (samples.begin(), samples.begin() + (std::ptrdiff_t) juce::jmin (firstValid - begin, count));
+
+        return samples;
+    }
+
+    PaintProfiler::Summary PaintProfiler::getSummary (int source, int numFrames) const
+    {
+        const auto frame = getCurrentFrame();
+        const auto frames = juce::jmax (1, juce::jmin (numFrames, (int) frame));
+
+        std::vector<double> durations;
+        Summary summary;
+        for (const auto& sample : getSamples())
+        {
+            // Only frames that have finished painting count
+            if (sample.source != source || sample.frame >= frame || frame - sample.frame > (juce::uint32) frames)
+                continue;
+
+            durations.push_back (sample.getDurationMs());
+            summary.areaPerFrame += (double) sample.area;
+        }
+
+        if (durations.empty())
+            return summary;
+
+        std::sort (durations.begin(), durations.end());
+        summary.numSamples = (int) durations.size();
+        summary.p50Ms = getPercentile (durations, 50.0);
+        summary.p95Ms = getPercentile (durations, 95.0);
+        summary.maxMs = durations.back();
+        summary.callsPerFrame = (double) durations.size() / (double) frames;
+        summary.areaPerFrame /= (double) frames;
+        return summary;
+    }
+
+    void PaintProfiler::writeCSV (juce::OutputStream& out) const
+    {
+        const auto samples = getSamples();
+        const auto origin = samples.empty() ? 0 : samples.front().startTicks;
+
+        out << "source,frame,start_ms,duration_ms,area_px\n";
+        for (const auto& sample : samples)
+        {
+            out << sample.source << ","
+                << (juce::int64) sample.frame << ","
+                << juce::String (juce::Time::highResolutionTicksToSeconds (sample.startTicks - origin) * 1000.0, 4) << ","
+                << juce::String (sample.getDurationMs(), 4) << ","
+                << sample.area << "\n";
+        }
+    }
+
+    void PaintProfiler::writeChromeTrace (juce::OutputStream& out, const juce::StringArray& sourceNames) const
+    {
+        const auto samples = getSamples();
+        const auto origin = samples.empty() ? 0 : samples.front().startTicks;
+        const auto toMicroseconds = [] (juce::int64 ticks) {
+            return juce::String (juce::Time::highResolutionTicksToSeconds (ticks) * 1.0e6, 3);
+        };
+
+        out << "{\"traceEvents\":[";
+
+        // Names the track of each component
+        auto first = true;
+        for (auto i = 0; i < sourceNames.size(); ++i)
+        {
+            out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << i
+                << ",\"args\":{\"name\":" << juce::JSON::toString (sourceNames[i]) << "}}";
+            first = false;
+        }
+
+        for (const auto& sample : samples)
+        {
+            out << (first ? "" : ",") << "\n{\"name\":\"paint\",\"ph\":\"X\",\"pid\":1,\"tid\":" << sample.source
+                << ",\"ts\":" << toMicroseconds (sample.startTicks - origin)
+                << ",\"dur\":" << toMicroseconds (sample.endTicks - sample.startTicks)
+                << ",\"args\":{\"frame\":" << (juce::int64) sample.frame << ",\"area\":" << sample.area << "}}";
+            first = false;
+        }
+
+        out << "\n]}\n";
+    }
+
+} // namespace BogrenDigital
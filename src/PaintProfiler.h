@@ -0,0 +1,82 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Records how long each compared component takes to paint.
+     * @details Samples are kept in a fixed-size ring buffer. The message
+     * thread adds them without locking or allocating, and any thread can read
+     * or export them at the same time. A sample that was overwritten while it
+     * was being read is dropped from the result.
+     */
+    class PaintProfiler
+    {
+    public:
+        struct Sample
+        {
+            int source = 0; // Index of the component that painted
+            juce::uint32 frame = 0; // Paint pass of the SplitView the paint belonged to
+            juce::int64 startTicks = 0; // juce::Time::getHighResolutionTicks()
+            juce::int64 endTicks = 0;
+            juce::int64 area = 0; // Repainted area in logical pixels
+
+            double getDurationMs() const;
+        };
+
+        /**
+         * @brief Rolling statistics of one component over the last few frames.
+         */
+        struct Summary
+        {
+            int numSamples = 0;
+            double p50Ms = 0.0, p95Ms = 0.0, maxMs = 0.0;
+            double callsPerFrame = 0.0;
+            double areaPerFrame = 0.0;
+        };
+
+        static constexpr int capacity = 4096;
+
+        PaintProfiler();
+
+        /** Adds a sample. Only call this from one thread, the message thread. */
+        void addSample (const Sample& sample) noexcept;
+
+        /** Starts a new frame. Only call this from the thread that adds samples. */
+        void endFrame() noexcept { currentFrame.fetch_add (1, std::memory_order_relaxed); }
+        juce::uint32 getCurrentFrame() const noexcept { return currentFrame.load (std::memory_order_relaxed); }
+
+        /** Returns up to maxSamples of the most recent samples, oldest first. */
+        std::vector<Sample> getSamples (int maxSamples = capacity) const;
+
+        /** Summarises the samples of source in the last numFrames frames. */
+        Summary getSummary (int source, int numFrames) const;
+
+        /**
+         * @brief Writes all samples as CSV, one row per paint, with the times
+         * in milliseconds since the first sample.
+         */
+        void writeCSV (juce::OutputStream& out) const;
+
+        /**
+         * @brief Writes all samples in the Chrome trace event format, with one
+         * track per component, for chrome://tracing or Perfetto.
+         * @param sourceNames Track names, indexed by source.
+         */
+        void writeChromeTrace (juce::OutputStream& out, const juce::StringArray& sourceNames = {}) const;
+
+    private:
+        std::vector<Sample> ring;
+        std::atomic<juce::uint64> numWritten { 0 };
+        std::atomic<juce::uint32> currentFrame { 0 };
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PaintProfiler)
+    };
+
+} // namespace BogrenDigital
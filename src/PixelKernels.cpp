@@ -0,0 +1,662 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#if JUCE_INTEL
+    #include <immintrin.h>
+    #define BD_SPLITVIEW_USE_SSE2 1
+    #if JUCE_GCC || JUCE_CLANG
+        #define BD_SPLITVIEW_AVX2_TARGET __attribute__ ((target ("avx2")))
+    #else
+        #define BD_SPLITVIEW_AVX2_TARGET
+    #endif
+#elif JUCE_ARM && (defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(_M_ARM64))
+    #include <arm_neon.h>
+    #define BD_SPLITVIEW_USE_NEON 1
+#endif
+
+namespace BogrenDigital
+{
+    namespace PixelKernels
+    {
+        namespace
+        {
+            juce::uint32 getAlphaMask() noexcept
+            {
+                return juce::PixelARGB (255, 0, 0, 0).getNativeARGB();
+            }
+
+#if BD_SPLITVIEW_USE_SSE2
+            bool hasAVX2() noexcept
+            {
+                static const bool available = juce::SystemStats::hasAVX2();
+                return available;
+            }
+#endif
+
+            //==============================================================================
+            void absoluteDifferenceScalar (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int gain) noexcept
+            {
+                const auto alphaMask = getAlphaMask();
+
+                for (auto i = 0; i < numPixels; ++i)
+                {
+                    juce::uint32 pixel = 0;
+                    for (auto c = 0; c < 4; ++c)
+                    {
+                        const auto delta = std::abs ((int) a[c] - (int) b[c]) * gain;
+                        pixel |= (juce::uint32) juce::jmin (255, delta) << (c * 8);
+                    }
+
+                    pixel = juce::ByteOrder::swapIfBigEndian (pixel) | alphaMask;
+                    std::memcpy (dest, &pixel, sizeof (pixel));
+                    a += 4;
+                    b += 4;
+                    dest += 4;
+                }
+            }
+
+            void maxChannelDifferenceScalar (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels) noexcept
+            {
+                const auto* pa = reinterpret_cast<const juce::PixelARGB*> (a);
+                const auto* pb = reinterpret_cast<const juce::PixelARGB*> (b);
+
+                for (auto i = 0; i < numPixels; ++i)
+                {
+                    const auto dr = std::abs ((int) pa[i].getRed() - (int) pb[i].getRed());
+                    const auto dg = std::abs ((int) pa[i].getGreen() - (int) pb[i].getGreen());
+                    const auto db = std::abs ((int) pa[i].getBlue() - (int) pb[i].getBlue());
+                    dest[i] = (juce::uint8) juce::jmax (dr, dg, db);
+                }
+            }
+
+            juce::uint64 sumSquaredDifferenceScalar (const juce::uint8* a, const juce::uint8* b, int numPixels) noexcept
+            {
+                const auto* pa = reinterpret_cast<const juce::PixelARGB*> (a);
+                const auto* pb = reinterpret_cast<const juce::PixelARGB*> (b);
+
+                juce::uint64 sum = 0;
+                for (auto i = 0; i < numPixels; ++i)
+                {
+                    const auto dr = (int) pa[i].getRed() - (int) pb[i].getRed();
+                    const auto dg = (int) pa[i].getGreen() - (int) pb[i].getGreen();
+                    const auto db = (int) pa[i].getBlue() - (int) pb[i].getBlue();
+                    sum += (juce::uint64) (dr * dr + dg * dg + db * db);
+                }
+
+                return sum;
+            }
+
+            void blendScalar (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int amount) noexcept
+            {
+                const auto* pa = reinterpret_cast<const juce::PixelARGB*> (a);
+
+                for (auto i = 0; i < numPixels; ++i)
+                {
+                    // Premultiplied, so every channel of b is scaled by what is left of a's alpha
+                    const auto inverse = 256 - ((pa[i].getAlpha() * amount) >> 8);
+                    for (auto c = 0; c < 4; ++c)
+                        dest[c] = (juce::uint8) juce::jmin (255, ((a[c] * amount) >> 8) + ((b[c] * inverse) >> 8));
+
+                    a += 4;
+                    b += 4;
+                    dest += 4;
+                }
+            }
+
+            //==============================================================================
+#if BD_SPLITVIEW_USE_SSE2
+            int absoluteDifferenceSSE2 (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int gain) noexcept
+            {
+                const auto zero = _mm_setzero_si128();
+                const auto gain16 = _mm_set1_epi16 ((short) gain);
+                const auto alpha = _mm_set1_epi32 ((int) getAlphaMask());
+
+                auto i = 0;
+                for (; i + 4 <= numPixels; i += 4)
+                {
+                    const auto va = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (a + i * 4));
+                    const auto vb = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (b + i * 4));
+                    auto delta = _mm_or_si128 (_mm_subs_epu8 (va, vb), _mm_subs_epu8 (vb, va));
+
+                    if (gain > 1)
+                    {
+                        const auto lo = _mm_mullo_epi16 (_mm_unpacklo_epi8 (delta, zero), gain16);
+                        const auto hi = _mm_mullo_epi16 (_mm_unpackhi_epi8 (delta, zero), gain16);
+                        delta = _mm_packus_epi16 (lo, hi);
+                    }
+
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 4), _mm_or_si128 (delta, alpha));
+                }
+
+                return i;
+            }
+
+            int maxChannelDifferenceSSE2 (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels) noexcept
+            {
+                const auto lowByte = _mm_set1_epi32 (0xff);
+
+                const auto maxOfFour = [&] (int offset) {
+                    const auto va = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (a + offset * 4));
+                    const auto vb = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (b + offset * 4));
+                    const auto delta = _mm_or_si128 (_mm_subs_epu8 (va, vb), _mm_subs_epu8 (vb, va));
+                    // Bytes 0-2 of each pixel hold blue, green and red
+                    auto m = _mm_max_epu8 (delta, _mm_srli_epi32 (delta, 8));
+                    m = _mm_max_epu8 (m, _mm_srli_epi32 (delta, 16));
+                    return _mm_and_si128 (m, lowByte);
+                };
+
+                auto i = 0;
+                for (; i + 16 <= numPixels; i += 16)
+                {
+                    const auto lo = _mm_packs_epi32 (maxOfFour (i), maxOfFour (i + 4));
+                    const auto hi = _mm_packs_epi32 (maxOfFour (i + 8), maxOfFour (i + 12));
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i), _mm_packus_epi16 (lo, hi));
+                }
+
+                return i;
+            }
+
+            int sumSquaredDifferenceSSE2 (const juce::uint8* a, const juce::uint8* b, int numPixels, juce::uint64& sum) noexcept
+            {
+                const auto zero = _mm_setzero_si128();
+                const auto colourMask = _mm_set1_epi32 ((int) ~getAlphaMask());
+                auto acc = _mm_setzero_si128();
+
+                auto i = 0;
+                for (; i + 4 <= numPixels; i += 4)
+                {
+                    const auto va = _mm_and_si128 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (a + i * 4)), colourMask);
+                    const auto vb = _mm_and_si128 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (b + i * 4)), colourMask);
+                    const auto delta = _mm_or_si128 (_mm_subs_epu8 (va, vb), _mm_subs_epu8 (vb, va));
+                    const auto lo = _mm_unpacklo_epi8 (delta, zero);
+                    const auto hi = _mm_unpackhi_epi8 (delta, zero);
+                    acc = _mm_add_epi32 (acc, _mm_add_epi32 (_mm_madd_epi16 (lo, lo), _mm_madd_epi16 (hi, hi)));
+                }
+
+                alignas (16) juce::uint32 lanes[4];
+                _mm_store_si128 (reinterpret_cast<__m128i*> (lanes), acc);
+                sum = (juce::uint64) lanes[0] + lanes[1] + lanes[2] + lanes[3];
+                return i;
+            }
+
+            // Blends two 16-bit unpacked pixels of a and b
+            __m128i blendPixelsSSE2 (__m128i a, __m128i b, __m128i amount) noexcept
+            {
+                const auto scaled = _mm_srli_epi16 (_mm_mullo_epi16 (a, amount), 8);
+                const auto alpha = _mm_shufflehi_epi16 (_mm_shufflelo_epi16 (scaled, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+                const auto inverse = _mm_sub_epi16 (_mm_set1_epi16 (256), alpha);
+                return _mm_add_epi16 (scaled, _mm_srli_epi16 (_mm_mullo_epi16 (b, inverse), 8));
+            }
+
+            int blendSSE2 (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int amount) noexcept
+            {
+                const auto zero = _mm_setzero_si128();
+                const auto amount16 = _mm_set1_epi16 ((short) amount);
+
+                auto i = 0;
+                for (; i + 4 <= numPixels; i += 4)
+                {
+                    const auto va = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (a + i * 4));
+                    const auto vb = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (b + i * 4));
+                    const auto lo = blendPixelsSSE2 (_mm_unpacklo_epi8 (va, zero), _mm_unpacklo_epi8 (vb, zero), amount16);
+                    const auto hi = blendPixelsSSE2 (_mm_unpackhi_epi8 (va, zero), _mm_unpackhi_epi8 (vb, zero), amount16);
+                    _mm_storeu_si128 (reinterpret_cast<__m128i*> (dest + i * 4), _mm_packus_epi16 (lo, hi));
+                }
+
+                return i;
+            }
+
+            BD_SPLITVIEW_AVX2_TARGET int absoluteDifferenceAVX2 (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int gain) noexcept
+            {
+                const auto zero = _mm256_setzero_si256();
+                const auto gain16 = _mm256_set1_epi16 ((short) gain);
+                const auto alpha = _mm256_set1_epi32 ((int) getAlphaMask());
+
+                auto i = 0;
+                for (; i + 8 <= numPixels; i += 8)
+                {
+                    const auto va = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (a + i * 4));
+                    const auto vb = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (b + i * 4));
+                    auto delta = _mm256_or_si256 (_mm256_subs_epu8 (va, vb), _mm256_subs_epu8 (vb, va));
+
+                    if (gain > 1)
+                    {
+                        // Unpack and pack both work per 128-bit lane, so the pixel order is preserved
+                        const auto lo = _mm256_mullo_epi16 (_mm256_unpacklo_epi8 (delta, zero), gain16);
+                        const auto hi = _mm256_mullo_epi16 (_mm256_unpackhi_epi8 (delta, zero), gain16);
+                        delta = _mm256_packus_epi16 (lo, hi);
+                    }
+
+                    _mm256_storeu_si256 (reinterpret_cast<__m256i*> (dest + i * 4), _mm256_or_si256 (delta, alpha));
+                }
+
+                return i;
+            }
+
+            // Lambdas don't inherit the target attribute, so this has to be a function
+            BD_SPLITVIEW_AVX2_TARGET __m256i maxOfEightAVX2 (const juce::uint8* a, const juce::uint8* b) noexcept
+            {
+                const auto va = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (a));
+                const auto vb = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (b));
+                const auto delta = _mm256_or_si256 (_mm256_subs_epu8 (va, vb), _mm256_subs_epu8 (vb, va));
+                auto m = _mm256_max_epu8 (delta, _mm256_srli_epi32 (delta, 8));
+                m = _mm256_max_epu8 (m, _mm256_srli_epi32 (delta, 16));
+                return _mm256_and_si256 (m, _mm256_set1_epi32 (0xff));
+            }
+
+            BD_SPLITVIEW_AVX2_TARGET int maxChannelDifferenceAVX2 (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels) noexcept
+            {
+                const auto order = _mm256_setr_epi32 (0, 4, 1, 5, 2, 6, 3, 7);
+
+                auto i = 0;
+                for (; i + 32 <= numPixels; i += 32)
+                {
+                    const auto lo = _mm256_packs_epi32 (maxOfEightAVX2 (a + i * 4, b + i * 4), maxOfEightAVX2 (a + (i + 8) * 4, b + (i + 8) * 4));
+                    const auto hi = _mm256_packs_epi32 (maxOfEightAVX2 (a + (i + 16) * 4, b + (i + 16) * 4), maxOfEightAVX2 (a + (i + 24) * 4, b + (i + 24) * 4));
+                    // The packs interleave the 128-bit lanes, so put the 4-pixel groups back in order
+                    const auto packed = _mm256_permutevar8x32_epi32 (_mm256_packus_epi16 (lo, hi), order);
+                    _mm256_storeu_si256 (reinterpret_cast<__m256i*> (dest + i), packed);
+                }
+
+                return i;
+            }
+            BD_SPLITVIEW_AVX2_TARGET int sumSquaredDifferenceAVX2 (const juce::uint8* a, const juce::uint8* b, int numPixels, juce::uint64& sum) noexcept
+            {
+                const auto zero = _mm256_setzero_si256();
+                const auto colourMask = _mm256_set1_epi32 ((int) ~getAlphaMask());
+                auto acc = _mm256_setzero_si256();
+
+                auto i = 0;
+                for (; i + 8 <= numPixels; i += 8)
+                {
+                    const auto va = _mm256_and_si256 (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (a + i * 4)), colourMask);
+                    const auto vb = _mm256_and_si256 (_mm256_loadu_si256 (reinterpret_cast<const __m256i*> (b + i * 4)), colourMask);
+                    const auto delta = _mm256_or_si256 (_mm256_subs_epu8 (va, vb), _mm256_subs_epu8 (vb, va));
+                    const auto lo = _mm256_unpacklo_epi8 (delta, zero);
+                    const auto hi = _mm256_unpackhi_epi8 (delta, zero);
+                    acc = _mm256_add_epi32 (acc, _mm256_add_epi32 (_mm256_madd_epi16 (lo, lo), _mm256_madd_epi16 (hi, hi)));
+                }
+
+                alignas (32) juce::uint32 lanes[8];
+                _mm256_store_si256 (reinterpret_cast<__m256i*> (lanes), acc);
+                sum = 0;
+                for (auto lane : lanes)
+                    sum += lane;
+                return i;
+            }
+
+            BD_SPLITVIEW_AVX2_TARGET __m256i blendPixelsAVX2 (__m256i a, __m256i b, __m256i amount) noexcept
+            {
+                const auto scaled = _mm256_srli_epi16 (_mm256_mullo_epi16 (a, amount), 8);
+                const auto alpha = _mm256_shufflehi_epi16 (_mm256_shufflelo_epi16 (scaled, _MM_SHUFFLE (3, 3, 3, 3)), _MM_SHUFFLE (3, 3, 3, 3));
+                const auto inverse = _mm256_sub_epi16 (_mm256_set1_epi16 (256), alpha);
+                return _mm256_add_epi16 (scaled, _mm256_srli_epi16 (_mm256_mullo_epi16 (b, inverse), 8));
+            }
+
+            BD_SPLITVIEW_AVX2_TARGET int blendAVX2 (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int amount) noexcept
+            {
+                const auto zero = _mm256_setzero_si256();
+                const auto amount16 = _mm256_set1_epi16 ((short) amount);
+
+                auto i = 0;
+                for (; i + 8 <= numPixels; i += 8)
+                {
+                    const auto va = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (a + i * 4));
+                    const auto vb = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (b + i * 4));
+                    const auto lo = blendPixelsAVX2 (_mm256_unpacklo_epi8 (va, zero), _mm256_unpacklo_epi8 (vb, zero), amount16);
+                    const auto hi = blendPixelsAVX2 (_mm256_unpackhi_epi8 (va, zero), _mm256_unpackhi_epi8 (vb, zero), amount16);
+                    _mm256_storeu_si256 (reinterpret_cast<__m256i*> (dest + i * 4), _mm256_packus_epi16 (lo, hi));
+                }
+
+                return i;
+            }
+#endif
+
+#if BD_SPLITVIEW_USE_NEON
+            int sumSquaredDifferenceNEON (const juce::uint8* a, const juce::uint8* b, int numPixels, juce::uint64& sum) noexcept
+            {
+                const auto colourMask = vreinterpretq_u8_u32 (vdupq_n_u32 (~getAlphaMask()));
+                auto acc = vdupq_n_u32 (0);
+
+                auto i = 0;
+                for (; i + 4 <= numPixels; i += 4)
+                {
+                    const auto delta = vandq_u8 (vabdq_u8 (vld1q_u8 (a + i * 4), vld1q_u8 (b + i * 4)), colourMask);
+                    acc = vpadalq_u16 (acc, vmull_u8 (vget_low_u8 (delta), vget_low_u8 (delta)));
+                    acc = vpadalq_u16 (acc, vmull_u8 (vget_high_u8 (delta), vget_high_u8 (delta)));
+                }
+
+                sum = (juce::uint64) vgetq_lane_u32 (acc, 0) + vgetq_lane_u32 (acc, 1) + vgetq_lane_u32 (acc, 2) + vgetq_lane_u32 (acc, 3);
+                return i;
+            }
+
+            int absoluteDifferenceNEON (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int gain) noexcept
+            {
+                const auto gain8 = vdup_n_u8 ((juce::uint8) gain);
+                const auto alpha = vreinterpretq_u8_u32 (vdupq_n_u32 (getAlphaMask()));
+
+                auto i = 0;
+                for (; i + 4 <= numPixels; i += 4)
+                {
+                    auto delta = vabdq_u8 (vld1q_u8 (a + i * 4), vld1q_u8 (b + i * 4));
+
+                    if (gain > 1)
+                        delta = vcombine_u8 (vqmovn_u16 (vmull_u8 (vget_low_u8 (delta), gain8)),
+                            vqmovn_u16 (vmull_u8 (vget_high_u8 (delta), gain8)));
+
+                    vst1q_u8 (dest + i * 4, vorrq_u8 (delta, alpha));
+                }
+
+                return i;
+            }
+
+            int maxChannelDifferenceNEON (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels) noexcept
+            {
+                auto i = 0;
+                for (; i + 16 <= numPixels; i += 16)
+                {
+                    // De-interleaves into blue, green, red and alpha planes
+                    const auto va = vld4q_u8 (a + i * 4);
+                    const auto vb = vld4q_u8 (b + i * 4);
+                    auto m = vabdq_u8 (va.val[0], vb.val[0]);
+                    m = vmaxq_u8 (m, vabdq_u8 (va.val[1], vb.val[1]));
+                    m = vmaxq_u8 (m, vabdq_u8 (va.val[2], vb.val[2]));
+                    vst1q_u8 (dest + i, m);
+                }
+
+                return i;
+            }
+
+            int blendNEON (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int amount) noexcept
+            {
+                const auto amount16 = vdupq_n_u16 ((juce::uint16) amount);
+                const auto full = vdupq_n_u16 (256);
+
+                auto i = 0;
+                for (; i + 16 <= numPixels; i += 16)
+                {
+                    const auto va = vld4q_u8 (a + i * 4);
+                    const auto vb = vld4q_u8 (b + i * 4);
+
+                    const auto scale = [&] (uint8x8_t plane, uint16x8_t factor) {
+                        return vshrq_n_u16 (vmulq_u16 (vmovl_u8 (plane), factor), 8);
+                    };
+
+                    const auto inverseLo = vsubq_u16 (full, scale (vget_low_u8 (va.val[3]), amount16));
+                    const auto inverseHi = vsubq_u16 (full, scale (vget_high_u8 (va.val[3]), amount16));
+
+                    uint8x16x4_t result;
+                    for (auto p = 0; p < 4; ++p)
+                    {
+                        const auto lo = vaddq_u16 (scale (vget_low_u8 (va.val[p]), amount16), scale (vget_low_u8 (vb.val[p]), inverseLo));
+                        const auto hi = vaddq_u16 (scale (vget_high_u8 (va.val[p]), amount16), scale (vget_high_u8 (vb.val[p]), inverseHi));
+                        result.val[p] = vcombine_u8 (vqmovn_u16 (lo), vqmovn_u16 (hi));
+                    }
+
+                    vst4q_u8 (dest + i * 4, result);
+                }
+
+                return i;
+            }
+#endif
+
+            //==============================================================================
+            std::array<juce::uint32, 256> createHeatmapTable (int gain)
+            {
+                juce::ColourGradient gradient (juce::Colours::black, 0.0f, 0.0f, juce::Colours::white, 1.0f, 0.0f, false);
+                gradient.addColour (0.2, juce::Colour (0xff1b0c41));
+                gradient.addColour (0.4, juce::Colour (0xff8c2369));
+                gradient.addColour (0.6, juce::Colour (0xffe55c30));
+                gradient.addColour (0.8, juce::Colour (0xfff6d746));
+
+                std::array<juce::uint32, 256> table {};
+                for (auto i = 0; i < (int) table.size(); ++i)
+                {
+                    const auto level = (double) juce::jmin (255, i * gain) / 255.0;
+                    table[(size_t) i] = gradient.getColourAtPosition (level).getPixelARGB().getNativeARGB();
+                }
+
+                return table;
+            }
+
+            /**
+             * Calls renderRows (area, firstRow, endRow) in parallel over the given
+             * areas. A single large area is split by rows, a list of tiles by tile.
+             */
+            template <typename RenderRows>
+            void forEachRowRange (const std::vector<juce::Rectangle<int>>& areas, juce::Rectangle<int> frameBounds, WorkerPool& pool, RenderRows&& renderRows)
+            {
+                if (areas.size() == 1)
+                {
+                    const auto area = areas.front().getIntersection (frameBounds);
+                    pool.parallelFor (area.getHeight(), 16, [&] (int begin, int end) {
+                        renderRows (area, area.getY() + begin, area.getY() + end);
+                    });
+                    return;
+                }
+
+                pool.parallelFor ((int) areas.size(), 4, [&] (int begin, int end) {
+                    for (auto i = begin; i < end; ++i)
+                    {
+                        const auto area = areas[(size_t) i].getIntersection (frameBounds);
+                        renderRows (area, area.getY(), area.getBottom());
+                    }
+                });
+            }
+        } // namespace
+
+        //==============================================================================
+        void absoluteDifference (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int gain) noexcept
+        {
+            gain = juce::jlimit (1, maxDifferenceGain, gain);
+            auto done = 0;
+
+#if BD_SPLITVIEW_USE_SSE2
+            done = hasAVX2() ? absoluteDifferenceAVX2 (a, b, dest, numPixels, gain)
+                             : absoluteDifferenceSSE2 (a, b, dest, numPixels, gain);
+#elif BD_SPLITVIEW_USE_NEON
+            done = absoluteDifferenceNEON (a, b, dest, numPixels, gain);
+#endif
+
+            absoluteDifferenceScalar (a + done * 4, b + done * 4, dest + done * 4, numPixels - done, gain);
+        }
+
+        void maxChannelDifference (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels) noexcept
+        {
+            auto done = 0;
+
+#if BD_SPLITVIEW_USE_SSE2
+            done = hasAVX2() ? maxChannelDifferenceAVX2 (a, b, dest, numPixels)
+                             : maxChannelDifferenceSSE2 (a, b, dest, numPixels);
+#elif BD_SPLITVIEW_USE_NEON
+            done = maxChannelDifferenceNEON (a, b, dest, numPixels);
+#endif
+
+            maxChannelDifferenceScalar (a + done * 4, b + done * 4, dest + done, numPixels - done);
+        }
+
+        juce::uint64 sumSquaredDifference (const juce::uint8* a, const juce::uint8* b, int numPixels) noexcept
+        {
+            juce::uint64 sum = 0;
+            auto done = 0;
+
+#if BD_SPLITVIEW_USE_SSE2
+            done = hasAVX2() ? sumSquaredDifferenceAVX2 (a, b, numPixels, sum)
+                             : sumSquaredDifferenceSSE2 (a, b, numPixels, sum);
+#elif BD_SPLITVIEW_USE_NEON
+            done = sumSquaredDifferenceNEON (a, b, numPixels, sum);
+#endif
+
+            return sum + sumSquaredDifferenceScalar (a + done * 4, b + done * 4, numPixels - done);
+        }
+
+        void blend (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int amount) noexcept
+        {
+            amount = juce::jlimit (0, 256, amount);
+            auto done = 0;
+
+#if BD_SPLITVIEW_USE_SSE2
+            done = hasAVX2() ? blendAVX2 (a, b, dest, numPixels, amount)
+                             : blendSSE2 (a, b, dest, numPixels, amount);
+#elif BD_SPLITVIEW_USE_NEON
+            done = blendNEON (a, b, dest, numPixels, amount);
+#endif
+
+            blendScalar (a + done * 4, b + done * 4, dest + done * 4, numPixels - done, amount);
+        }
+
+        void renderDifference (const juce::Image& a,
+            const juce::Image& b,
+            juce::Image& dest,
+            const std::vector<juce::Rectangle<int>>& areas,
+            DifferenceOptions options,
+            WorkerPool& pool)
+        {
+            jassert (a.getBounds() == b.getBounds() && a.getBounds() == dest.getBounds());
+            jassert (a.getFormat() == juce::Image::ARGB && b.getFormat() == juce::Image::ARGB && dest.getFormat() == juce::Image::ARGB);
+
+            const auto frameBounds = a.getBounds().getIntersection (b.getBounds()).getIntersection (dest.getBounds());
+            if (areas.empty() || frameBounds.isEmpty())
+                return;
+
+            const juce::Image::BitmapData dataA (a, juce::Image::BitmapData::readOnly);
+            const juce::Image::BitmapData dataB (b, juce::Image::BitmapData::readOnly);
+            juce::Image::BitmapData dataDest (dest, juce::Image::BitmapData::readWrite);
+            jassert (dataA.pixelStride == 4 && dataB.pixelStride == 4 && dataDest.pixelStride == 4);
+
+            const auto heatmapTable = options.heatmap ? createHeatmapTable (options.gain) : std::array<juce::uint32, 256> {};
+
+            forEachRowRange (areas, frameBounds, pool, [&] (juce::Rectangle<int> area, int firstRow, int endRow) {
+                const auto width = area.getWidth();
+                std::vector<juce::uint8> levels (options.heatmap ? (size_t) width : 0);
+
+                for (auto y = firstRow; y < endRow; ++y)
+                {
+                    const auto* rowA = dataA.getPixelPointer (area.getX(), y);
+                    const auto* rowB = dataB.getPixelPointer (area.getX(), y);
+                    auto* rowDest = dataDest.getPixelPointer (area.getX(), y);
+
+                    if (!options.heatmap)
+                    {
+                        absoluteDifference (rowA, rowB, rowDest, width, options.gain);
+                        continue;
+                    }
+
+                    maxChannelDifference (rowA, rowB, levels.data(), width);
+                    auto* pixels = reinterpret_cast<juce::uint32*> (rowDest);
+                    for (auto x = 0; x < width; ++x)
+                        pixels[x] = heatmapTable[levels[(size_t) x]];
+                }
+            });
+        }
+
+        void renderBlend (const juce::Image& a,
+            const juce::Image& b,
+            juce::Image& dest,
+            const std::vector<juce::Rectangle<int>>& areas,
+            int amount,
+            WorkerPool& pool)
+        {
+            jassert (a.getBounds() == b.getBounds() && a.getBounds() == dest.getBounds());
+            jassert (a.getFormat() == juce::Image::ARGB && b.getFormat() == juce::Image::ARGB && dest.getFormat() == juce::Image::ARGB);
+
+            const auto frameBounds = a.getBounds().getIntersection (b.getBounds()).getIntersection (dest.getBounds());
+            if (areas.empty() || frameBounds.isEmpty())
+                return;
+
+            const juce::Image::BitmapData dataA (a, juce::Image::BitmapData::readOnly);
+            const juce::Image::BitmapData dataB (b, juce::Image::BitmapData::readOnly);
+            juce::Image::BitmapData dataDest (dest, juce::Image::BitmapData::readWrite);
+            jassert (dataA.pixelStride == 4 && dataB.pixelStride == 4 && dataDest.pixelStride == 4);
+
+            forEachRowRange (areas, frameBounds, pool, [&] (juce::Rectangle<int> area, int firstRow, int endRow) {
+                for (auto y = firstRow; y < endRow; ++y)
+                    blend (dataA.getPixelPointer (area.getX(), y),
+                        dataB.getPixelPointer (area.getX(), y),
+                        dataDest.getPixelPointer (area.getX(), y),
+                        area.getWidth(),
+                        amount);
+            });
+        }
+
+        void magnify (const juce::Image& source, juce::Rectangle<int> sourceArea, juce::Image& dest, int zoom)
+        {
+            jassert (source.getFormat() == juce::Image::ARGB && dest.getFormat() == juce::Image::ARGB);
+            jassert (zoom > 0);
+
+            const auto columns = juce::jmin (sourceArea.getWidth(), dest.getWidth() / zoom);
+            const auto rows = juce::jmin (sourceArea.getHeight(), dest.getHeight() / zoom);
+            if (columns <= 0 || rows <= 0)
+                return;
+
+            const juce::Image::BitmapData sourceData (source, juce::Image::BitmapData::readOnly);
+            juce::Image::BitmapData destData (dest, juce::Image::BitmapData::writeOnly);
+            jassert (sourceData.pixelStride == 4 && destData.pixelStride == 4);
+
+            const auto rowBytes = (size_t) (columns * zoom) * sizeof (juce::uint32);
+
+            for (auto row = 0; row < rows; ++row)
+            {
+                auto* firstLine = reinterpret_cast<juce::uint32*> (destData.getLinePointer (row * zoom));
+                const auto y = sourceArea.getY() + row;
+
+                if (!juce::isPositiveAndBelow (y, sourceData.height))
+                {
+                    std::fill_n (firstLine, columns * zoom, 0u);
+                }
+                else
+                {
+                    const auto* sourceLine = reinterpret_cast<const juce::uint32*> (sourceData.getLinePointer (y));
+                    for (auto column = 0; column < columns; ++column)
+                    {
+                        const auto x = sourceArea.getX() + column;
+                        const auto pixel = juce::isPositiveAndBelow (x, sourceData.width) ? sourceLine[x] : 0u;
+                        std::fill_n (firstLine + column * zoom, zoom, pixel);
+                    }
+                }
+
+                for (auto copy = 1; copy < zoom; ++copy)
+                    std::memcpy (destData.getLinePointer (row * zoom + copy), firstLine, rowBytes);
+            }
+        }
+
+        juce::Image halve (const juce::Image& source, WorkerPool& pool)
+        {
+            jassert (source.getFormat() == juce::Image::ARGB);
+
+            juce::Image dest (juce::Image::ARGB, juce::jmax (1, source.getWidth() / 2), juce::jmax (1, source.getHeight() / 2), false);
+            const juce::Image::BitmapData sourceData (source, juce::Image::BitmapData::readOnly);
+            juce::Image::BitmapData destData (dest, juce::Image::BitmapData::writeOnly);
+            jassert (sourceData.pixelStride == 4 && destData.pixelStride == 4);
+
+            // Sources of width or height 1 average the same pixel twice
+            const auto lastX = sourceData.width - 1;
+            const auto lastY = sourceData.height - 1;
+
+            pool.parallelFor (destData.height, 16, [&] (int begin, int end) {
+                for (auto y = begin; y < end; ++y)
+                {
+                    const auto* top = sourceData.getLinePointer (juce::jmin (y * 2, lastY));
+                    const auto* bottom = sourceData.getLinePointer (juce::jmin (y * 2 + 1, lastY));
+                    auto* out = destData.getLinePointer (y);
+
+                    for (auto x = 0; x < destData.width; ++x)
+                    {
+                        const auto left = juce::jmin (x * 2, lastX) * 4;
+                        const auto right = juce::jmin (x * 2 + 1, lastX) * 4;
+
+                        // Premultiplied channels average without any unpremultiplying
+                        for (auto c = 0; c < 4; ++c)
+                            out[x * 4 + c] = (juce::uint8) ((top[left + c] + top[right + c] + bottom[left + c] + bottom[right + c] + 2) >> 2);
+                    }
+                }
+            });
+
+            return dest;
+        }
+    } // namespace PixelKernels
+
+} // namespace BogrenDigital
@@ -0,0 +1,104 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+    class WorkerPool;
+
+    /**
+     * @brief Vectorised kernels that work on rows of 32-bit premultiplied ARGB
+     * pixels, as stored in juce::Image::ARGB images.
+     * @details Each kernel picks AVX2, SSE2 or NEON at runtime/compile time and
+     * falls back to plain C++ on other targets. Rows may alias the destination.
+     */
+    namespace PixelKernels
+    {
+        /** Largest gain accepted by the difference kernels. */
+        constexpr int maxDifferenceGain = 128;
+
+        /**
+         * @brief Writes the per-channel absolute difference of a and b,
+         * multiplied by gain and saturated, as opaque pixels.
+         */
+        void absoluteDifference (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int gain) noexcept;
+
+        /**
+         * @brief Writes one byte per pixel holding the largest absolute
+         * difference of the red, green and blue channels of a and b.
+         */
+        void maxChannelDifference (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels) noexcept;
+
+        /**
+         * @brief Returns the sum of the squared differences of the red, green and
+         * blue channels of a and b. Rows must be shorter than 65536 pixels.
+         */
+        juce::uint64 sumSquaredDifference (const juce::uint8* a, const juce::uint8* b, int numPixels) noexcept;
+
+        /**
+         * @brief Composites a over b, with the opacity of a scaled by
+         * amount / 256, and writes the result to dest.
+         * @param amount Weight of a, from 0 (only b) to 256 (a over b).
+         */
+        void blend (const juce::uint8* a, const juce::uint8* b, juce::uint8* dest, int numPixels, int amount) noexcept;
+
+        /**
+         * @brief Options for renderDifference().
+         * @param gain Amplification applied to the differences, 1 to maxDifferenceGain.
+         * @param heatmap If true, the largest channel difference of each pixel
+         * is mapped through a false-colour scale instead of showing |A-B| per channel.
+         */
+        struct DifferenceOptions
+        {
+            int gain = 1;
+            bool heatmap = false;
+        };
+
+        /**
+         * @brief Renders the difference of two equally sized ARGB images into
+         * dest, which must have the same size, restricted to the given areas.
+         * The areas, or the rows of a single area, are processed in parallel on
+         * the given pool.
+         */
+        void renderDifference (const juce::Image& a,
+            const juce::Image& b,
+            juce::Image& dest,
+            const std::vector<juce::Rectangle<int>>& areas,
+            DifferenceOptions options,
+            WorkerPool& pool);
+
+        /**
+         * @brief Renders a blended over b into dest, restricted to the given
+         * areas, in the same way as renderDifference().
+         * @param amount Weight of a, from 0 to 256. See blend().
+         */
+        void renderBlend (const juce::Image& a,
+            const juce::Image& b,
+            juce::Image& dest,
+            const std::vector<juce::Rectangle<int>>& areas,
+            int amount,
+            WorkerPool& pool);
+
+        /**
+         * @brief Scales sourceArea of source up by an integer factor without
+         * filtering, so each source pixel becomes a zoom x zoom block in dest,
+         * starting at its top left. Parts of sourceArea outside source come
+         * out transparent.
+         * @details Each destination row is built once and copied zoom - 1
+         * times, which is cheap enough to run on every mouse move.
+         */
+        void magnify (const juce::Image& source, juce::Rectangle<int> sourceArea, juce::Image& dest, int zoom);
+
+        /**
+         * @brief Returns source at half its width and height, rounded down but
+         * at least 1, with each pixel the average of a 2x2 block, for building
+         * mip levels. Rows are processed in parallel on the given pool.
+         */
+        juce::Image halve (const juce::Image& source, WorkerPool& pool);
+    } // namespace PixelKernels
+
+} // namespace BogrenDigital
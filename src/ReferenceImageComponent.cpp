@@ -0,0 +1,130 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    ReferenceImageComponent::ReferenceImageComponent (const juce::File& fileToShow)
+        : decodeJob ([this] { return prepareDecode(); },
+                     [this] (Decoded&& decoded) {
+                         levels = std::move (decoded.levels);
+                         firstLevel = decoded.firstLevel;
+                         imageSize = decoded.imageSize;
+                         repaint();
+                     })
+    {
+        setOpaque (false);
+        setFile (fileToShow);
+    }
+
+    void ReferenceImageComponent::setFile (const juce::File& newFile)
+    {
+        file = newFile;
+        lastModified = file.getLastModificationTime();
+        decodeJob.cancel();
+
+        levels.clear();
+        firstLevel = 0;
+        imageSize = {};
+        needsLoad = true;
+
+        // There is no portable file watcher, and the modification time is cheap to poll
+        if (file != juce::File())
+            startTimer (1000);
+        else
+            stopTimer();
+
+        repaint();
+    }
+
+    void ReferenceImageComponent::setPlacement (juce::RectanglePlacement newPlacement)
+    {
+        placement = newPlacement;
+        repaint();
+    }
+
+    void ReferenceImageComponent::paint (juce::Graphics& g)
+    {
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        const auto physicalBounds = (getLocalBounds().toFloat() * scale).getSmallestIntegerContainer();
+        const auto targetSize = juce::Point<int> (physicalBounds.getWidth(), physicalBounds.getHeight());
+
+        // Finer levels are only decoded again if the ones that were dropped are needed now
+        const auto needsFinerLevels = firstLevel > 0 && (targetSize.x > requestedTarget.x || targetSize.y > requestedTarget.y);
+        if (needsLoad || needsFinerLevels)
+            requestLevels (targetSize);
+
+        if (levels.empty())
+            return;
+
+        const auto dest = placement.appliedTo (juce::Rectangle<float> ((float) imageSize.x, (float) imageSize.y), getLocalBounds().toFloat());
+
+        // The coarsest level that is still at least as large as the destination
+        auto index = (int) levels.size() - 1;
+        while (index > 0 && ((float) levels[(size_t) index].getWidth() < dest.getWidth() * scale || (float) levels[(size_t) index].getHeight() < dest.getHeight() * scale))
+            --index;
+
+        g.setImageResamplingQuality (juce::Graphics::mediumResamplingQuality);
+        g.drawImage (levels[(size_t) index], dest);
+    }
+
+    void ReferenceImageComponent::requestLevels (juce::Point<int> targetSize)
+    {
+        needsLoad = false;
+        requestedTarget = targetSize;
+        pendingTarget = targetSize;
+        decodeJob.request();
+    }
+
+    CoalescingJob<ReferenceImageComponent::Decoded>::Work ReferenceImageComponent::prepareDecode()
+    {
+        if (!pendingTarget)
+            return nullptr;
+
+        return [this, fileToDecode = file, targetSize = *std::exchange (pendingTarget, std::nullopt)] (const auto& shouldCancel) {
+            Decoded decoded;
+            auto image = juce::ImageFileFormat::loadFrom (fileToDecode);
+
+            if (image.isValid() && !shouldCancel())
+            {
+                image = image.convertedToFormat (juce::Image::ARGB);
+                decoded.imageSize = { image.getWidth(), image.getHeight() };
+
+                std::vector<juce::Image> pyramid { image };
+                image = {};
+                while (!shouldCancel() && (pyramid.back().getWidth() > 1 || pyramid.back().getHeight() > 1))
+                    pyramid.push_back (PixelKernels::halve (pyramid.back(), *workerPool));
+
+                // Levels finer than the target are never drawn at this size
+                size_t first = 0;
+                while (first + 1 < pyramid.size()
+                       && pyramid[first + 1].getWidth() >= targetSize.x
+                       && pyramid[first + 1].getHeight() >= targetSize.y)
+                    ++first;
+
+                decoded.levels.assign (pyramid.begin() + (std::ptrdiff_t) first, pyramid.end());
+                decoded.firstLevel = (int) first;
+            }
+
+            return decoded;
+        };
+    }
+
+    void ReferenceImageComponent::timerCallback()
+    {
+        const auto modified = file.getLastModificationTime();
+        if (modified == lastModified)
+            return;
+
+        // The previous image stays up until the new one is decoded
+        lastModified = modified;
+        decodeJob.cancel();
+
+        needsLoad = true;
+        repaint();
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,74 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Shows an image file, such as a mockup, as one side of a SplitView.
+     * @details The file is only decoded once the component is first painted,
+     * on a background thread. A mip pyramid is built from it, and each paint
+     * draws the smallest level that is still at least as large as the
+     * destination, so scaling never costs more than a 2:1 reduction. Levels
+     * finer than the current size are dropped, so a huge export costs little
+     * memory in a small window; they are decoded again if the window grows.
+     * The file is reloaded whenever it changes on disk.
+     */
+    class ReferenceImageComponent : public juce::Component,
+                                    private juce::Timer
+    {
+    public:
+        explicit ReferenceImageComponent (const juce::File& file = {});
+
+        /** Shows another file. It is decoded on the next paint. */
+        void setFile (const juce::File& newFile);
+        const juce::File& getFile() const { return file; }
+
+        /**
+         * @brief Sets how the image is fitted into the bounds. Default is
+         * juce::RectanglePlacement::centred, which keeps the aspect ratio.
+         */
+        void setPlacement (juce::RectanglePlacement newPlacement);
+
+        /** Returns the size of the image file in pixels, or an empty point before it's decoded. */
+        juce::Point<int> getImageSize() const { return imageSize; }
+
+        void paint (juce::Graphics& g) override;
+
+    private:
+        struct Decoded
+        {
+            std::vector<juce::Image> levels;
+            int firstLevel = 0;
+            juce::Point<int> imageSize;
+        };
+
+        void timerCallback() override;
+        void requestLevels (juce::Point<int> targetSize);
+        CoalescingJob<Decoded>::Work prepareDecode();
+
+        juce::File file;
+        juce::Time lastModified;
+        juce::RectanglePlacement placement { juce::RectanglePlacement::centred };
+
+        // levels[i] is the image at 1 / 2^(firstLevel + i) of its full size
+        std::vector<juce::Image> levels;
+        int firstLevel = 0;
+        juce::Point<int> imageSize;
+
+        std::optional<juce::Point<int>> pendingTarget; // Levels finer than needed for this are dropped
+        juce::Point<int> requestedTarget;
+        bool needsLoad = false;
+
+        juce::SharedResourcePointer<WorkerPool> workerPool;
+        CoalescingJob<Decoded> decodeJob;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ReferenceImageComponent)
+    };
+
+} // namespace BogrenDigital
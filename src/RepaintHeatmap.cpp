@@ -0,0 +1,123 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    void RepaintHeatmap::setSize (int newWidth, int newHeight)
+    {
+        if (newWidth == width && newHeight == height)
+            return;
+
+        width = juce::jmax (0, newWidth);
+        height = juce::jmax (0, newHeight);
+        columns = (width + cellSize - 1) / cellSize;
+        rows = (height + cellSize - 1) / cellSize;
+        heat.assign ((size_t) columns * (size_t) rows, 0.0f);
+    }
+
+    void RepaintHeatmap::clear()
+    {
+        std::fill (heat.begin(), heat.end(), 0.0f);
+        bucketPixels.fill (0.0);
+    }
+
+    void RepaintHeatmap::record (juce::Rectangle<int> area, double nowSeconds)
+    {
+        area = area.getIntersection ({ width, height });
+        if (area.isEmpty())
+            return;
+
+        advanceWindow (nowSeconds);
+        bucketPixels[(size_t) (currentBucket % numBuckets)] += (double) area.getWidth() * (double) area.getHeight();
+
+        constexpr auto cellArea = (float) (cellSize * cellSize);
+        const auto firstColumn = area.getX() / cellSize, lastColumn = (area.getRight() - 1) / cellSize;
+        const auto firstRow = area.getY() / cellSize, lastRow = (area.getBottom() - 1) / cellSize;
+
+        for (auto row = firstRow; row <= lastRow; ++row)
+        {
+            const auto cellTop = row * cellSize;
+            const auto coveredHeight = juce::jmin (area.getBottom(), cellTop + cellSize) - juce::jmax (area.getY(), cellTop);
+            auto* cells = heat.data() + (size_t) row * (size_t) columns;
+
+            for (auto column = firstColumn; column <= lastColumn; ++column)
+            {
+                const auto cellLeft = column * cellSize;
+                const auto coveredWidth = juce::jmin (area.getRight(), cellLeft + cellSize) - juce::jmax (area.getX(), cellLeft);
+                cells[column] += (float) (coveredWidth * coveredHeight) / cellArea;
+            }
+        }
+    }
+
+    void RepaintHeatmap::decay (double nowSeconds)
+    {
+        const auto elapsed = nowSeconds - lastDecay;
+        lastDecay = nowSeconds;
+        if (elapsed <= 0.0)
+            return;
+
+        const auto factor = (float) std::exp2 (-elapsed / halfLifeSeconds);
+        for (auto& cellHeat : heat)
+            cellHeat *= factor;
+    }
+
+    void RepaintHeatmap::advanceWindow (double nowSeconds)
+    {
+        const auto bucket = (juce::int64) (nowSeconds * (double) numBuckets / windowSeconds);
+
+        // Buckets the window moved past since the last call start again from zero
+        for (auto i = currentBucket + 1; i <= bucket && i <= currentBucket + numBuckets; ++i)
+            bucketPixels[(size_t) (i % numBuckets)] = 0.0;
+
+        currentBucket = juce::jmax (currentBucket, bucket);
+    }
+
+    double RepaintHeatmap::getPixelsPerSecond (double nowSeconds)
+    {
+        advanceWindow (nowSeconds);
+        return std::accumulate (bucketPixels.begin(), bucketPixels.end(), 0.0) / windowSeconds;
+    }
+
+    float RepaintHeatmap::getOpacity (float cellHeat) const
+    {
+        // A cell repainted at a steady rate settles at rate * halfLife / ln 2
+        constexpr auto fullHeat = (float) (saturationRate * halfLifeSeconds / 0.6931471805599453);
+        return juce::jmin (1.0f, cellHeat / fullHeat);
+    }
+
+    juce::Rectangle<int> RepaintHeatmap::getWarmArea() const
+    {
+        juce::Rectangle<int> area;
+        for (auto row = 0; row < rows; ++row)
+        {
+            for (auto column = 0; column < columns; ++column)
+            {
+                if (getOpacity (heat[(size_t) (row * columns + column)]) >= 0.01f)
+                    area = area.getUnion ({ column * cellSize, row * cellSize, cellSize, cellSize });
+            }
+        }
+
+        return area;
+    }
+
+    void RepaintHeatmap::paint (juce::Graphics& g, juce::Colour colour) const
+    {
+        for (auto row = 0; row < rows; ++row)
+        {
+            for (auto column = 0; column < columns; ++column)
+            {
+                const auto opacity = getOpacity (heat[(size_t) (row * columns + column)]);
+                if (opacity < 0.01f)
+                    continue;
+
+                g.setColour (colour.withMultipliedAlpha (0.15f + 0.55f * opacity));
+                g.fillRect (column * cellSize, row * cellSize, cellSize, cellSize);
+            }
+        }
+    }
+
+} // namespace BogrenDigital
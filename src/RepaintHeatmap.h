@@ -0,0 +1,68 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Accumulates the areas a component invalidates, as a decaying
+     * heat grid and as a rate of pixels per second.
+     * @details Each invalidated rectangle adds the fraction of each cell it
+     * covers to that cell, so recording costs a few additions per cell
+     * touched, and nothing is allocated after the size is set. The rate is
+     * summed over a sliding window of short buckets. Only use it on the
+     * message thread.
+     */
+    class RepaintHeatmap
+    {
+    public:
+        static constexpr int cellSize = 16; // Logical pixels
+        static constexpr double halfLifeSeconds = 0.5;
+        static constexpr double saturationRate = 30.0; // Repaints per second that show at full heat
+
+        RepaintHeatmap() = default;
+
+        /** Sets the size of the component, in logical pixels. Clears the grid if it changed. */
+        void setSize (int width, int height);
+
+        /** Adds an invalidated area, in the component's coordinates. */
+        void record (juce::Rectangle<int> area, double nowSeconds);
+
+        /** Cools the grid down to the given time. */
+        void decay (double nowSeconds);
+
+        /** Returns the pixels invalidated per second over the last windowSeconds. */
+        double getPixelsPerSecond (double nowSeconds);
+
+        /** Returns the bounding box of the cells that are visibly warm. */
+        juce::Rectangle<int> getWarmArea() const;
+
+        /** Fills each warm cell with colour, at an opacity that rises with its heat. */
+        void paint (juce::Graphics& g, juce::Colour colour) const;
+
+        void clear();
+
+        static constexpr double windowSeconds = 1.0;
+
+    private:
+        void advanceWindow (double nowSeconds);
+        float getOpacity (float cellHeat) const;
+
+        int width = 0, height = 0;
+        int columns = 0, rows = 0;
+        std::vector<float> heat; // Decayed number of full repaints, per cell
+        double lastDecay = 0.0;
+
+        static constexpr int numBuckets = 10;
+        std::array<double, numBuckets> bucketPixels {};
+        juce::int64 currentBucket = 0;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (RepaintHeatmap)
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,466 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+    // Lives at the start of the file, followed by the slots at pixelOffset
+    struct SharedFrameChannel::Header
+    {
+        std::atomic<juce::uint32> magic; // Written last by the producer
+        juce::uint32 version;
+        juce::int32 width, height, lineStride;
+        juce::uint64 sessionId;
+
+        std::atomic<juce::uint32> closed;
+        std::atomic<juce::uint32> latestSlot; // The newest published frame, or noSlot
+        std::atomic<juce::uint32> heldSlot; // The frame the consumer has mapped, or noSlot
+        std::array<std::atomic<juce::uint32>, numSlots> sequences; // Odd while the producer writes the slot
+        std::atomic<juce::uint64> numFramesPublished;
+
+        std::atomic<juce::uint32> messagesWritten, messagesRead;
+        std::array<MouseMessage, mouseQueueCapacity> messages;
+    };
+
+    namespace
+    {
+        // Both processes use the atomics in place, which is only safe if they never take a lock
+        static_assert (std::atomic<juce::uint32>::is_always_lock_free && std::atomic<juce::uint64>::is_always_lock_free);
+        static_assert (std::is_trivially_copyable_v<SharedFrameChannel::MouseMessage>);
+
+        constexpr juce::uint32 magicValue = 0x46534442; // "BDSF"
+        constexpr juce::uint32 currentVersion = 1;
+        constexpr juce::uint32 noSlot = 0xffffffff;
+        constexpr size_t pixelOffset = 65536; // Past the header, on a page boundary
+
+        /** Pixels of a slot in the mapped file, used in place. */
+        class MappedPixelData : public juce::ImagePixelData
+        {
+        public:
+            MappedPixelData (std::shared_ptr<juce::MemoryMappedFile> mappedFile, juce::uint8* firstPixel, int w, int h)
+                : juce::ImagePixelData (juce::Image::ARGB, w, h), mapping (std::move (mappedFile)), pixels (firstPixel)
+            {
+            }
+
+            std::unique_ptr<juce::LowLevelGraphicsContext> createLowLevelContext() override
+            {
+                sendDataChangeMessage();
+                return std::make_unique<juce::LowLevelGraphicsSoftwareRenderer> (juce::Image (this));
+            }
+
+            void initialiseBitmapData (juce::Image::BitmapData& bitmap, int x, int y, juce::Image::BitmapData::ReadWriteMode mode) override
+            {
+                const auto offset = (size_t) y * (size_t) getLineStride() + (size_t) x * 4;
+                bitmap.data = pixels + offset;
+                bitmap.size = (size_t) height * (size_t) getLineStride() - offset;
+                bitmap.pixelFormat = pixelFormat;
+                bitmap.lineStride = getLineStride();
+                bitmap.pixelStride = 4;
+
+                if (mode != juce::Image::BitmapData::readOnly)
+                    sendDataChangeMessage();
+            }
+
+            juce::ImagePixelData::Ptr clone() override
+            {
+                // A copy is an ordinary image, so later frames don't change it
+                juce::Image copy (juce::Image::ARGB, width, height, false);
+                const juce::Image::BitmapData dest (copy, juce::Image::BitmapData::writeOnly);
+                for (auto y = 0; y < height; ++y)
+                    std::memcpy (dest.getLinePointer (y), pixels + (size_t) y * (size_t) getLineStride(), (size_t) width * 4);
+
+                return copy.getPixelData();
+            }
+
+            std::unique_ptr<juce::ImageType> createType() const override
+            {
+                return std::make_unique<juce::SoftwareImageType>();
+            }
+
+        private:
+            int getLineStride() const { return width * 4; }
+
+            std::shared_ptr<juce::MemoryMappedFile> mapping;
+            juce::uint8* pixels;
+        };
+    } // namespace
+
+    //==============================================================================
+    SharedFrameChannel::SharedFrameChannel (const juce::File& channelFile, std::shared_ptr<juce::MemoryMappedFile> mappedFile, bool isProducer)
+        : file (channelFile),
+          mapping (std::move (mappedFile)),
+          header (*static_cast<Header*> (mapping->getData())),
+          producer (isProducer),
+          width (header.width),
+          height (header.height)
+    {
+        static_assert (sizeof (Header) <= pixelOffset);
+    }
+
+    SharedFrameChannel::~SharedFrameChannel()
+    {
+        if (!producer)
+            return;
+
+        // Consumers keep their mapping until they notice; the file itself can go
+        header.closed.store (1);
+        file.deleteFile();
+    }
+
+    juce::File SharedFrameChannel::getFile (const juce::String& name)
+    {
+        return juce::File::getSpecialLocation (juce::File::tempDirectory)
+            .getChildFile ("bd_splitview_" + juce::File::createLegalFileName (name) + ".frames");
+    }
+
+    std::unique_ptr<SharedFrameChannel> SharedFrameChannel::create (const juce::String& name, int width, int height)
+    {
+        if (width <= 0 || height <= 0)
+            return nullptr;
+
+        // Consumers of a previous channel keep mapping the old file until they reopen
+        const auto file = getFile (name);
+        file.deleteFile();
+
+        const auto lineStride = width * 4;
+        const auto totalSize = pixelOffset + (size_t) numSlots * (size_t) lineStride * (size_t) height;
+        {
+            juce::FileOutputStream out (file);
+            if (out.failedToOpen() || !out.setPosition ((juce::int64) totalSize - 1) || !out.writeByte (0))
+                return nullptr;
+        }
+
+        auto mapping = std::make_shared<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readWrite);
+        if (mapping->getData() == nullptr || mapping->getSize() < totalSize)
+            return nullptr;
+
+        auto* header = new (mapping->getData()) Header();
+        header->version = currentVersion;
+        header->width = width;
+        header->height = height;
+        header->lineStride = lineStride;
+        header->sessionId = (juce::uint64) juce::Random::getSystemRandom().nextInt64();
+        header->closed.store (0);
+        header->latestSlot.store (noSlot);
+        header->heldSlot.store (noSlot);
+        for (auto& sequence : header->sequences)
+            sequence.store (0);
+        header->numFramesPublished.store (0);
+        header->messagesWritten.store (0);
+        header->messagesRead.store (0);
+        header->magic.store (magicValue, std::memory_order_release);
+
+        return std::unique_ptr<SharedFrameChannel> (new SharedFrameChannel (file, std::move (mapping), true));
+    }
+
+    std::unique_ptr<SharedFrameChannel> SharedFrameChannel::open (const juce::String& name)
+    {
+        const auto file = getFile (name);
+        if (!file.existsAsFile())
+            return nullptr;
+
+        auto mapping = std::make_shared<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readWrite);
+        if (mapping->getData() == nullptr || mapping->getSize() < pixelOffset)
+            return nullptr;
+
+        const auto& header = *static_cast<const Header*> (mapping->getData());
+        if (header.magic.load (std::memory_order_acquire) != magicValue || header.version != currentVersion || header.closed.load() != 0)
+            return nullptr;
+
+        if (header.width <= 0 || header.height <= 0 || header.lineStride != header.width * 4
+            || mapping->getSize() < pixelOffset + (size_t) numSlots * (size_t) header.lineStride * (size_t) header.height)
+            return nullptr;
+
+        return std::unique_ptr<SharedFrameChannel> (new SharedFrameChannel (file, std::move (mapping), false));
+    }
+
+    juce::uint64 SharedFrameChannel::getSessionId() const
+    {
+        return header.sessionId;
+    }
+
+    juce::Image SharedFrameChannel::getSlotImage (int slot) const
+    {
+        auto* pixels = static_cast<juce::uint8*> (mapping->getData()) + pixelOffset + (size_t) slot * (size_t) header.lineStride * (size_t) height;
+        return juce::Image (new MappedPixelData (mapping, pixels, width, height));
+    }
+
+    //==============================================================================
+    juce::Image SharedFrameChannel::beginFrame()
+    {
+        jassert (producer);
+        if (writingSlot >= 0)
+            return {};
+
+        for (;;)
+        {
+            const auto latest = header.latestSlot.load();
+            const auto held = header.heldSlot.load();
+
+            // Three slots always leave one that is neither
+            auto slot = 0u;
+            while (slot == latest || slot == held)
+                ++slot;
+
+            auto& sequence = header.sequences[slot];
+            const auto stable = sequence.load();
+            sequence.store (stable + 1);
+
+            // The consumer may have mapped the slot since held was read. Both
+            // sides store, then load what the other stored, so at least one of
+            // them sees the other: either this backs off, or the consumer sees
+            // the odd sequence and tries again.
+            if (header.heldSlot.load() != slot)
+            {
+                writingSlot = (int) slot;
+                return getSlotImage (writingSlot);
+            }
+
+            sequence.store (stable);
+        }
+    }
+
+    void SharedFrameChannel::endFrame()
+    {
+        jassert (producer);
+        if (writingSlot < 0)
+            return;
+
+        auto& sequence = header.sequences[(size_t) writingSlot];
+        sequence.store (sequence.load() + 1);
+        header.latestSlot.store ((juce::uint32) writingSlot);
+        header.numFramesPublished.fetch_add (1);
+        writingSlot = -1;
+    }
+
+    bool SharedFrameChannel::popMouseMessage (MouseMessage& message)
+    {
+        const auto read = header.messagesRead.load (std::memory_order_relaxed);
+        if (read == header.messagesWritten.load (std::memory_order_acquire))
+            return false;
+
+        message = header.messages[read % mouseQueueCapacity];
+        header.messagesRead.store (read + 1, std::memory_order_release);
+        return true;
+    }
+
+    //==============================================================================
+    juce::Image SharedFrameChannel::takeLatestFrame()
+    {
+        jassert (!producer);
+        const auto published = header.numFramesPublished.load();
+        if (published == lastTakenFrame)
+            return {};
+
+        // Bounded, so a producer that keeps winning can't stall the message thread
+        for (auto attempt = 0; attempt < 4; ++attempt)
+        {
+            const auto slot = header.latestSlot.load();
+            if (slot >= (juce::uint32) numSlots)
+                break;
+
+            auto& sequence = header.sequences[slot];
+            const auto stable = sequence.load();
+            if ((stable & 1) != 0)
+                continue;
+
+            header.heldSlot.store (slot);
+            if (sequence.load() == stable)
+            {
+                takenSlot = (int) slot;
+                takenSequence = stable;
+                lastTakenFrame = published;
+                return getSlotImage (takenSlot);
+            }
+
+            rehold();
+        }
+
+        return {};
+    }
+
+    void SharedFrameChannel::rehold()
+    {
+        if (takenSlot < 0)
+        {
+            header.heldSlot.store (noSlot);
+            return;
+        }
+
+        // The same store-then-load as beginFrame(): an unchanged sequence means
+        // the producer either hasn't picked the slot or has backed off from it
+        header.heldSlot.store ((juce::uint32) takenSlot);
+        if (header.sequences[(size_t) takenSlot].load() == takenSequence)
+            return;
+
+        takenSlot = -1;
+        header.heldSlot.store (noSlot);
+    }
+
+    bool SharedFrameChannel::pushMouseMessage (const MouseMessage& message)
+    {
+        const auto written = header.messagesWritten.load (std::memory_order_relaxed);
+        if (written - header.messagesRead.load (std::memory_order_acquire) >= (juce::uint32) mouseQueueCapacity)
+            return false;
+
+        header.messages[written % mouseQueueCapacity] = message;
+        header.messagesWritten.store (written + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool SharedFrameChannel::isClosed() const
+    {
+        return header.closed.load() != 0;
+    }
+
+    //==============================================================================
+    SharedFramePublisher::SharedFramePublisher (juce::Component& component, const juce::String& channelName, float scaleFactor, int framesPerSecond)
+        : source (component), name (channelName), scale (juce::jmax (0.1f, scaleFactor))
+    {
+        startTimerHz (juce::jlimit (1, 240, framesPerSecond));
+    }
+
+    SharedFramePublisher::~SharedFramePublisher()
+    {
+        stopTimer();
+    }
+
+    void SharedFramePublisher::timerCallback()
+    {
+        const juce::Point<int> size (juce::roundToInt ((float) source.getWidth() * scale), juce::roundToInt ((float) source.getHeight() * scale));
+        if (size.x <= 0 || size.y <= 0)
+            return;
+
+        if (channel == nullptr || size != channelSize)
+        {
+            if (retryCountdown > 0)
+            {
+                --retryCountdown;
+                return;
+            }
+
+            // The old channel deletes its file before the new one is created under the same name
+            channel.reset();
+            channel = SharedFrameChannel::create (name, size.x, size.y);
+
+            // E.g. a consumer on Windows still maps the old file, so try again, less often each time
+            if (channel == nullptr)
+            {
+                retryInterval = juce::jmin (retryInterval * 2, maxRetryInterval);
+                retryCountdown = retryInterval;
+                return;
+            }
+
+            channelSize = size;
+            retryInterval = 1;
+        }
+
+        SharedFrameChannel::MouseMessage message;
+        while (channel->popMouseMessage (message))
+            replay (message);
+
+        auto frame = channel->beginFrame();
+        if (frame.isNull())
+            return;
+
+        // Painted in place, so the consumer maps exactly these pixels
+        frame.clear (frame.getBounds());
+        {
+            juce::Graphics g (frame);
+            g.addTransform (juce::AffineTransform::scale (scale));
+            source.paintEntireComponent (g, true);
+        }
+
+        channel->endFrame();
+    }
+
+    void SharedFramePublisher::replay (const SharedFrameChannel::MouseMessage& message)
+    {
+        using Type = SharedFrameChannel::MouseMessage::Type;
+
+        const auto position = juce::Point<float> (message.x, message.y) / scale;
+        auto* target = source.getComponentAt (position.roundToInt());
+        const auto now = juce::Time::getCurrentTime();
+
+        const auto makeEvent = [&] (juce::Component& component) {
+            return juce::MouseEvent (juce::Desktop::getInstance().getMainMouseSource(),
+                component.getLocalPoint (&source, position),
+                juce::ModifierKeys (message.modifiers),
+                juce::MouseInputSource::defaultPressure,
+                juce::MouseInputSource::defaultOrientation,
+                juce::MouseInputSource::defaultRotation,
+                juce::MouseInputSource::defaultTiltX,
+                juce::MouseInputSource::defaultTiltY,
+                &component,
+                &component,
+                now,
+                component.getLocalPoint (&source, mouseDownPosition),
+                mouseDownTime,
+                message.numClicks,
+                message.type == Type::Drag || (message.type == Type::Up && position != mouseDownPosition));
+        };
+
+        switch (message.type)
+        {
+            case Type::Move:
+                if (hovered.getComponent() != target)
+                {
+                    if (hovered != nullptr)
+                        hovered->mouseExit (makeEvent (*hovered));
+
+                    hovered = target;
+                    if (target != nullptr)
+                        target->mouseEnter (makeEvent (*target));
+                }
+
+                if (target != nullptr)
+                    target->mouseMove (makeEvent (*target));
+                break;
+
+            case Type::Exit:
+                if (hovered != nullptr)
+                    hovered->mouseExit (makeEvent (*hovered));
+
+                hovered = nullptr;
+                break;
+
+            case Type::Down:
+                mouseDownTarget = target;
+                mouseDownPosition = position;
+                mouseDownTime = now;
+                if (target != nullptr)
+                    target->mouseDown (makeEvent (*target));
+                break;
+
+            case Type::Drag:
+                if (mouseDownTarget != nullptr)
+                    mouseDownTarget->mouseDrag (makeEvent (*mouseDownTarget));
+                break;
+
+            case Type::Up:
+                if (mouseDownTarget != nullptr)
+                    mouseDownTarget->mouseUp (makeEvent (*mouseDownTarget));
+
+                mouseDownTarget = nullptr;
+                break;
+
+            case Type::DoubleClick:
+                if (target != nullptr)
+                    target->mouseDoubleClick (makeEvent (*target));
+                break;
+
+            case Type::Wheel:
+                if (target != nullptr)
+                {
+                    juce::MouseWheelDetails wheel {};
+                    wheel.deltaX = message.wheelDeltaX;
+                    wheel.deltaY = message.wheelDeltaY;
+                    target->mouseWheelMove (makeEvent (*target), wheel);
+                }
+                break;
+        }
+    }
+
+} // namespace BogrenDigital
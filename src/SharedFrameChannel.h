@@ -0,0 +1,163 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Passes frames from one process to another through a memory-mapped
+     * file, and mouse input back, e.g. to compare against a build that can't
+     * be linked into the same binary.
+     * @details Frames go through a triple buffer: the producer renders
+     * straight into a slot that is neither the newest frame nor the one the
+     * consumer has mapped, and the consumer maps the newest frame into a
+     * juce::Image without copying it. Ownership of the slots is settled with
+     * atomic sequence counters, so neither side ever waits for the other; a
+     * consumer that loses a race simply tries again on its next poll. Mouse
+     * input goes back through a fixed-size ring buffer, and is dropped when
+     * the producer doesn't keep up. The channel is a file named after the
+     * channel in the temporary directory, created by the producer.
+     */
+    class SharedFrameChannel
+    {
+    public:
+        /** Mouse input on the consumer's side, in frame pixels. */
+        struct MouseMessage
+        {
+            enum class Type : juce::uint32 { Move,
+                Exit,
+                Down,
+                Drag,
+                Up,
+                DoubleClick,
+                Wheel };
+
+            Type type = Type::Move;
+            float x = 0.0f, y = 0.0f;
+            juce::int32 modifiers = 0; // juce::ModifierKeys::getRawFlags()
+            juce::int32 numClicks = 1;
+            float wheelDeltaX = 0.0f, wheelDeltaY = 0.0f;
+        };
+
+        ~SharedFrameChannel();
+
+        /** Creates the channel as its producer, replacing any previous one of the same name. */
+        static std::unique_ptr<SharedFrameChannel> create (const juce::String& name, int width, int height);
+
+        /** Opens the channel as its consumer, or returns nullptr if no producer created it. */
+        static std::unique_ptr<SharedFrameChannel> open (const juce::String& name);
+
+        static juce::File getFile (const juce::String& name);
+
+        int getWidth() const { return width; }
+        int getHeight() const { return height; }
+
+        /** Returns an identifier that is different for each time the channel is created. */
+        juce::uint64 getSessionId() const;
+
+        //==============================================================================
+        /**
+         * @brief Returns a free slot to render the next frame into, or a null
+         * image if a frame is already begun. Producer only.
+         * @details The slot holds an older frame; clear it first if the frame
+         * isn't opaque. The image is only valid until endFrame().
+         */
+        juce::Image beginFrame();
+
+        /** Publishes the frame returned by beginFrame(). Producer only. */
+        void endFrame();
+
+        /** Takes the oldest mouse message from the consumer, if there is one. Producer only. */
+        bool popMouseMessage (MouseMessage& message);
+
+        //==============================================================================
+        /**
+         * @brief Maps the newest frame, if one was published since the last
+         * frame this returned, or returns a null image. Consumer only.
+         * @details The producer doesn't touch the frame until the next call
+         * that returns a frame; after that, its contents may change at any
+         * time, so it must not be kept. A call that loses a race with the
+         * producer keeps the previous frame, unless the producer has already
+         * started overwriting it, in which case isHoldingFrame() turns false
+         * and the previous frame must be dropped as well.
+         */
+        juce::Image takeLatestFrame();
+
+        /** Returns false if the frame last returned by takeLatestFrame() may be overwritten. Consumer only. */
+        bool isHoldingFrame() const { return takenSlot >= 0; }
+
+        /** Queues a mouse message for the producer. Returns false if the queue is full. Consumer only. */
+        bool pushMouseMessage (const MouseMessage& message);
+
+        /** Returns true once the producer has closed the channel, e.g. to recreate it at another size. Consumer only. */
+        bool isClosed() const;
+
+        static constexpr int numSlots = 3;
+        static constexpr int mouseQueueCapacity = 256;
+
+    private:
+        struct Header;
+
+        SharedFrameChannel (const juce::File& channelFile, std::shared_ptr<juce::MemoryMappedFile> mappedFile, bool isProducer);
+        juce::Image getSlotImage (int slot) const;
+        void rehold();
+
+        const juce::File file;
+        std::shared_ptr<juce::MemoryMappedFile> mapping; // Shared with the images of the slots
+        Header& header;
+        const bool producer;
+        int width = 0, height = 0;
+
+        int writingSlot = -1; // Producer only
+        juce::uint64 lastTakenFrame = 0; // Consumer only
+        int takenSlot = -1; // Consumer only
+        juce::uint32 takenSequence = 0; // Consumer only
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedFrameChannel)
+    };
+
+    /**
+     * @brief The producer's side of a SharedFrameChannel: publishes a component
+     * at a fixed rate, and replays the mouse input from the consumer on it.
+     * @details The component is painted straight into the shared memory. The
+     * channel is recreated at the new size whenever the component is
+     * resized. Replayed mouse events go to the components' callbacks, like
+     * InputMirror's, so components that query the real mouse state, such as
+     * juce::Button, won't follow replayed clicks.
+     */
+    class SharedFramePublisher : private juce::Timer
+    {
+    public:
+        SharedFramePublisher (juce::Component& component, const juce::String& channelName, float scale = 1.0f, int framesPerSecond = 60);
+        ~SharedFramePublisher() override;
+
+        /** Returns false if the channel couldn't be created, e.g. for lack of disk space. */
+        bool isPublishing() const { return channel != nullptr; }
+
+    private:
+        void timerCallback() override;
+        void replay (const SharedFrameChannel::MouseMessage& message);
+
+        juce::Component& source;
+        const juce::String name;
+        const float scale;
+        std::unique_ptr<SharedFrameChannel> channel;
+        juce::Point<int> channelSize;
+
+        // Timer ticks before a failed create is tried again, doubling up to maxRetryInterval
+        int retryInterval = 1, retryCountdown = 0;
+        static constexpr int maxRetryInterval = 64;
+
+        juce::Component::SafePointer<juce::Component> hovered, mouseDownTarget;
+        juce::Point<float> mouseDownPosition;
+        juce::Time mouseDownTime;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedFramePublisher)
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,152 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    SharedFrameComponent::SharedFrameComponent (const juce::String& channelNameToShow)
+        : vBlankAttachment (this, [this] { pollFrame(); })
+    {
+        setOpaque (false);
+        setChannel (channelNameToShow);
+    }
+
+    SharedFrameComponent::~SharedFrameComponent() = default;
+
+    void SharedFrameComponent::setChannel (const juce::String& newChannelName)
+    {
+        channelName = newChannelName;
+        frame = {};
+        channel.reset();
+
+        if (channelName.isNotEmpty())
+        {
+            reconnect();
+            startTimer (1000);
+        }
+        else
+        {
+            stopTimer();
+        }
+
+        repaint();
+    }
+
+    void SharedFrameComponent::reconnect()
+    {
+        auto opened = SharedFrameChannel::open (channelName);
+
+        // The same session is kept, so the frame it holds stays protected
+        if (opened != nullptr && channel != nullptr && opened->getSessionId() == channel->getSessionId())
+            return;
+
+        frame = {};
+        channel = std::move (opened);
+        repaint();
+    }
+
+    void SharedFrameComponent::timerCallback()
+    {
+        // A producer that closed its channel is gone for good, but one that
+        // crashed leaves its channel open, so a silent channel is checked
+        // against the file, which a new producer would have replaced
+        if (channel == nullptr || channel->isClosed() || !receivedFrame)
+            reconnect();
+
+        receivedFrame = false;
+    }
+
+    void SharedFrameComponent::pollFrame()
+    {
+        if (channel == nullptr)
+            return;
+
+        auto latest = channel->takeLatestFrame();
+        if (latest.isNull())
+        {
+            // Only after a lost race with the producer; a later poll brings a newer frame
+            if (frame.isValid() && !channel->isHoldingFrame())
+            {
+                frame = {};
+                repaint();
+            }
+
+            return;
+        }
+
+        frame = std::move (latest);
+        receivedFrame = true;
+        repaint();
+    }
+
+    void SharedFrameComponent::paint (juce::Graphics& g)
+    {
+        if (frame.isNull())
+            return;
+
+        g.setImageResamplingQuality (juce::Graphics::mediumResamplingQuality);
+        g.drawImage (frame, getLocalBounds().toFloat());
+    }
+
+    //==============================================================================
+    void SharedFrameComponent::send (SharedFrameChannel::MouseMessage::Type type, const juce::MouseEvent& e, const juce::MouseWheelDetails* wheel)
+    {
+        if (channel == nullptr || getWidth() <= 0 || getHeight() <= 0)
+            return;
+
+        SharedFrameChannel::MouseMessage message;
+        message.type = type;
+        message.x = e.position.x * (float) channel->getWidth() / (float) getWidth();
+        message.y = e.position.y * (float) channel->getHeight() / (float) getHeight();
+        message.modifiers = e.mods.getRawFlags();
+        message.numClicks = e.getNumberOfClicks();
+
+        if (wheel != nullptr)
+        {
+            message.wheelDeltaX = wheel->deltaX;
+            message.wheelDeltaY = wheel->deltaY;
+        }
+
+        // A full queue means the producer has stalled, so the event is of no use to it anyway
+        channel->pushMouseMessage (message);
+    }
+
+    void SharedFrameComponent::mouseMove (const juce::MouseEvent& e)
+    {
+        send (SharedFrameChannel::MouseMessage::Type::Move, e);
+    }
+
+    void SharedFrameComponent::mouseExit (const juce::MouseEvent& e)
+    {
+        send (SharedFrameChannel::MouseMessage::Type::Exit, e);
+    }
+
+    void SharedFrameComponent::mouseDown (const juce::MouseEvent& e)
+    {
+        send (SharedFrameChannel::MouseMessage::Type::Down, e);
+    }
+
+    void SharedFrameComponent::mouseDrag (const juce::MouseEvent& e)
+    {
+        send (SharedFrameChannel::MouseMessage::Type::Drag, e);
+    }
+
+    void SharedFrameComponent::mouseUp (const juce::MouseEvent& e)
+    {
+        send (SharedFrameChannel::MouseMessage::Type::Up, e);
+    }
+
+    void SharedFrameComponent::mouseDoubleClick (const juce::MouseEvent& e)
+    {
+        send (SharedFrameChannel::MouseMessage::Type::DoubleClick, e);
+    }
+
+    void SharedFrameComponent::mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+    {
+        send (SharedFrameChannel::MouseMessage::Type::Wheel, e, &wheel);
+    }
+
+} // namespace BogrenDigital
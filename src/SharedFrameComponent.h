@@ -0,0 +1,62 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Shows the frames a SharedFramePublisher in another process
+     * publishes, and sends the mouse input on it back, as one side of a
+     * SplitView.
+     * @details The newest frame is polled on each vblank and drawn straight
+     * from the shared memory, stretched to the bounds. The channel is opened
+     * once the producer has created it, and reopened whenever the producer
+     * closes or recreates it, e.g. when it is restarted or resized. Nothing
+     * here ever waits for the producer.
+     */
+    class SharedFrameComponent : public juce::Component,
+                                 private juce::Timer
+    {
+    public:
+        explicit SharedFrameComponent (const juce::String& channelName = {});
+        ~SharedFrameComponent() override;
+
+        /** Shows another channel. It is opened as soon as its producer has created it. */
+        void setChannel (const juce::String& newChannelName);
+        const juce::String& getChannel() const { return channelName; }
+
+        /** Returns true while a producer is connected. */
+        bool isConnected() const { return channel != nullptr; }
+
+        void paint (juce::Graphics& g) override;
+
+        void mouseMove (const juce::MouseEvent& e) override;
+        void mouseExit (const juce::MouseEvent& e) override;
+        void mouseDown (const juce::MouseEvent& e) override;
+        void mouseDrag (const juce::MouseEvent& e) override;
+        void mouseUp (const juce::MouseEvent& e) override;
+        void mouseDoubleClick (const juce::MouseEvent& e) override;
+        void mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+
+    private:
+        void timerCallback() override;
+        void pollFrame();
+        void reconnect();
+        void send (SharedFrameChannel::MouseMessage::Type type, const juce::MouseEvent& e, const juce::MouseWheelDetails* wheel = nullptr);
+
+        juce::String channelName;
+        std::unique_ptr<SharedFrameChannel> channel;
+        juce::Image frame; // Mapped from the channel, so valid until the next frame is taken
+        bool receivedFrame = false; // Since the last timer callback
+
+        juce::VBlankAttachment vBlankAttachment;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SharedFrameComponent)
+    };
+
+} // namespace BogrenDigital
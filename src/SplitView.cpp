@@ -6,175 +6,1507 @@
 
 namespace BogrenDigital
 {
-    SplitView::ComponentWrapper::ComponentWrapper()
+    SplitView::ComponentWrapper::ComponentWrapper (OffscreenBufferPool& pool)
+        : bufferPool (pool)
     {
         setOpaque (false);
     }
 
     void SplitView::ComponentWrapper::setContent (juce::Component* component)
     {
+        suspender.resume();
+
         if (content)
             removeChildComponent (content);
 
-        content = component;
-        if (content)
-        {
-            addAndMakeVisible (content);
-            resized();
-        }
+        content = component;
+        if (content)
+        {
+            addAndMakeVisible (content);
+            resized();
+        }
+    }
+
+    void SplitView::ComponentWrapper::setSuspended (bool shouldBeSuspended)
+    {
+        if (shouldBeSuspended && content != nullptr)
+            suspender.suspend (*content);
+        else if (!shouldBeSuspended)
+            suspender.resume();
+    }
+
+    void SplitView::ComponentWrapper::resized()
+    {
+        if (content)
+            content->setBounds (getLocalBounds());
+    }
+
+    bool SplitView::ComponentWrapper::hitTest (int x, int y)
+    {
+        // The wrappers overlap, so each one only takes the mouse where it's shown
+        if (hitRegion.has_value() && !hitRegion->contains ({ (float) x, (float) y }))
+            return false;
+
+        return juce::Component::hitTest (x, y);
+    }
+
+    void SplitView::ComponentWrapper::paint (juce::Graphics& g)
+    {
+        if (onPainted)
+        {
+            paintArea = g.getClipBounds();
+            paintStartTicks = juce::Time::getHighResolutionTicks();
+        }
+    }
+
+    void SplitView::ComponentWrapper::paintOverChildren (juce::Graphics&)
+    {
+        if (onPainted)
+            onPainted (paintStartTicks, juce::Time::getHighResolutionTicks(), paintArea);
+    }
+
+    void SplitView::ComponentWrapper::setClipping (RenderingMode mode, const ClipRegion& clipRegion)
+    {
+        clearClipping();
+        hitRegion = clipRegion;
+
+        const auto imageMode = mode == RenderingMode::Snapshot          ? ClippedComponentImage::Mode::Snapshot
+                               : mode == RenderingMode::ComponentEffect ? ClippedComponentImage::Mode::Offscreen
+                                                                        : ClippedComponentImage::Mode::Direct;
+        clippedImage = new ClippedComponentImage (*this, clipRegion, imageMode, &bufferPool);
+        clippedImage->setContentTransform (contentTransform);
+        clippedImage->onSnapshotUpdated = [this] (const auto& area) { if (onSnapshotUpdated) onSnapshotUpdated (area); };
+        clippedImage->onInvalidated = [this] (auto area) { if (onInvalidated) onInvalidated (area); };
+        setCachedComponentImage (clippedImage);
+    }
+
+    void SplitView::ComponentWrapper::setCapturing (bool holdRepaints)
+    {
+        clearClipping();
+        clippedImage = new ClippedComponentImage (*this, getLocalBounds(), ClippedComponentImage::Mode::CaptureOnly);
+        clippedImage->onSnapshotUpdated = [this] (const auto& area) { if (onSnapshotUpdated) onSnapshotUpdated (area); };
+        clippedImage->onInvalidated = [this] (auto area) { if (onInvalidated) onInvalidated (area); };
+        clippedImage->setRepaintsHeld (holdRepaints);
+        setCachedComponentImage (clippedImage);
+    }
+
+    void SplitView::ComponentWrapper::setUnclipped()
+    {
+        clearClipping();
+        clippedImage = new ClippedComponentImage (*this, getLocalBounds(), ClippedComponentImage::Mode::Unclipped);
+        clippedImage->onInvalidated = [this] (auto area) { if (onInvalidated) onInvalidated (area); };
+        setCachedComponentImage (clippedImage);
+    }
+
+    bool SplitView::ComponentWrapper::takeHeldRepaint()
+    {
+        return clippedImage != nullptr && clippedImage->takeHeldRepaint();
+    }
+
+    juce::Image SplitView::ComponentWrapper::getSnapshot() const
+    {
+        return clippedImage != nullptr ? clippedImage->getSnapshot() : juce::Image();
+    }
+
+    void SplitView::ComponentWrapper::updateClipRegion (const ClipRegion& clipRegion)
+    {
+        if (hitRegion)
+            hitRegion = clipRegion;
+        if (clippedImage)
+            clippedImage->updateBounds (clipRegion);
+    }
+
+    void SplitView::ComponentWrapper::clearClipping()
+    {
+        setCachedComponentImage (nullptr); // Deletes clippedImage
+        clippedImage = nullptr;
+        hitRegion.reset();
+    }
+
+    void SplitView::ComponentWrapper::setContentTransform (const juce::AffineTransform& newTransform)
+    {
+        contentTransform = newTransform;
+        if (clippedImage)
+            clippedImage->setContentTransform (contentTransform);
+    }
+
+    SplitView::DividerComponent::DividerComponent (SplitView& parent, int dividerIndex)
+        : owner (parent), index (dividerIndex)
+    {
+        updateMouseCursor();
+    }
+
+    void SplitView::DividerComponent::updateMouseCursor()
+    {
+        setMouseCursor (std::abs (owner.getDividerAngle()) < 45.0f ? juce::MouseCursor::LeftRightResizeCursor
+                                                                   : juce::MouseCursor::UpDownResizeCursor);
+    }
+
+    void SplitView::DividerComponent::paint (juce::Graphics& g)
+    {
+        auto colour = (currentStyle == Style::Light) ? juce::Colours::white : juce::Colours::black;
+        g.setColour (colour.withAlpha (0.5f));
+        g.fillAll();
+    }
+
+    void SplitView::DividerComponent::mouseDown (const juce::MouseEvent&)
+    {
+        isDragging = true;
+    }
+
+    void SplitView::DividerComponent::mouseDrag (const juce::MouseEvent& e)
+    {
+        if (isDragging)
+        {
+            const auto pos = e.getEventRelativeTo (&owner).position;
+            owner.moveDividerOnNextFrame (index, owner.dividerGeometry.getProportionAt (pos));
+        }
+    }
+
+    void SplitView::DividerComponent::setStyle (Style style)
+    {
+        currentStyle = style;
+    }
+
+    SplitView::CompositeComponent::CompositeComponent (SplitView& parent)
+        : owner (parent)
+    {
+        setInterceptsMouseClicks (false, false);
+    }
+
+    void SplitView::CompositeComponent::paint (juce::Graphics& g)
+    {
+        auto* wrapperA = owner.getComparedWrapper (true);
+        auto* wrapperB = owner.getComparedWrapper (false);
+        if (wrapperA == nullptr || wrapperB == nullptr)
+            return;
+
+        // The wrappers sit below this component, so their snapshots were
+        // brought up to date earlier in this same paint pass
+        const auto snapshotA = wrapperA->getSnapshot();
+        const auto snapshotB = wrapperB->getSnapshot();
+        if (snapshotA.isNull() || snapshotB.isNull() || snapshotA.getBounds() != snapshotB.getBounds() || getWidth() <= 0)
+            return;
+
+        if (compositeImage.getBounds() != snapshotA.getBounds())
+        {
+            compositeImage = juce::Image (juce::Image::ARGB, snapshotA.getWidth(), snapshotA.getHeight(), true);
+            compositeTiles.reset();
+        }
+
+        // Only the tiles whose hash changed on either side since the last paint are recomposited
+        const auto& tilesA = wrapperA->getTiles();
+        auto dirtyTiles = compositeTiles.takeDirtyTiles (tilesA, wrapperB->getTiles());
+        const auto scale = (float) snapshotA.getWidth() / (float) getWidth();
+
+        auto sourceB = snapshotB;
+        if (owner.alignment.has_value())
+        {
+            // B moves as a whole, so a change anywhere in it can land in any tile
+            if (!dirtyTiles.empty() || alignedB.getBounds() != snapshotB.getBounds())
+            {
+                owner.drawAligned (snapshotB, alignedB, scale);
+
+                dirtyTiles.clear();
+                for (auto tile = 0; tile < tilesA.getGrid().getNumTiles(); ++tile)
+                    dirtyTiles.push_back (tile);
+            }
+
+            sourceB = alignedB;
+        }
+
+        if (!dirtyTiles.empty())
+        {
+            std::vector<juce::Rectangle<int>> areas;
+            areas.reserve (dirtyTiles.size());
+            for (auto tile : dirtyTiles)
+                areas.push_back (tilesA.getGrid().getTileBounds (tile));
+
+            if (owner.currentMode == ViewMode::Blend)
+                PixelKernels::renderBlend (snapshotA, sourceB, compositeImage, areas, juce::roundToInt (owner.blendAmount * 256.0f), *owner.workerPool);
+            else
+                PixelKernels::renderDifference (snapshotA, sourceB, compositeImage, areas, owner.differenceOptions, *owner.workerPool);
+        }
+
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+        g.drawImageTransformed (compositeImage, juce::AffineTransform::scale (1.0f / scale));
+    }
+
+    void SplitView::CompositeComponent::visibilityChanged()
+    {
+        if (!isVisible())
+        {
+            compositeImage = juce::Image();
+            alignedB = juce::Image();
+        }
+    }
+
+    void SplitView::CompositeComponent::invalidateComposite()
+    {
+        compositeTiles.reset();
+        alignedB = juce::Image();
+        repaint();
+    }
+
+    SplitView::HistoryComponent::HistoryComponent (SplitView& parent)
+        : owner (parent)
+    {
+        setInterceptsMouseClicks (false, false);
+    }
+
+    void SplitView::HistoryComponent::paint (juce::Graphics& g)
+    {
+        const auto& frameA = owner.history.getDecodedFrame (true);
+        const auto& frameB = owner.history.getDecodedFrame (false);
+        if (frameA.isNull() || getWidth() <= 0)
+            return;
+
+        // Drawn the way the live view draws the snapshots, B moved by the alignment
+        const auto scale = (float) frameA.getWidth() / (float) getWidth();
+        const auto transformA = juce::AffineTransform::scale (1.0f / scale);
+        const auto transformB = owner.alignment.has_value() ? transformA.followedBy (owner.alignment->getTransform()) : transformA;
+
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+
+        switch (owner.currentMode)
+        {
+            case ViewMode::Split:
+                for (const auto first : { true, false })
+                {
+                    juce::Graphics::ScopedSaveState state (g);
+                    if (owner.getPaneRegion (first ? owner.comparedA : owner.comparedB).reduceClipRegion (g))
+                        g.drawImageTransformed (first ? frameA : frameB, first ? transformA : transformB);
+                }
+                break;
+
+            case ViewMode::A:
+            case ViewMode::B:
+            case ViewMode::Single:
+                // Only the compared components are in the history
+                if (owner.getSingleComponentIndex() == owner.comparedA)
+                    g.drawImageTransformed (frameA, transformA);
+                else if (owner.getSingleComponentIndex() == owner.comparedB)
+                    g.drawImageTransformed (frameB, transformB);
+                break;
+
+            case ViewMode::Difference:
+            case ViewMode::Blend:
+                updateComposite (frameA, frameB, scale);
+                g.drawImageTransformed (compositeImage, transformA);
+                break;
+        }
+    }
+
+    void SplitView::HistoryComponent::updateComposite (const juce::Image& frameA, const juce::Image& frameB, float scale)
+    {
+        if (compositeImage.getBounds() != frameA.getBounds())
+        {
+            compositeImage = juce::Image (juce::Image::ARGB, frameA.getWidth(), frameA.getHeight(), true);
+            allTilesDirty = true;
+        }
+
+        auto sourceB = frameB;
+        if (owner.alignment.has_value())
+        {
+            // B moves as a whole, so a change anywhere in it can land in any tile
+            if (allTilesDirty || !dirtyTiles.empty() || alignedB.getBounds() != frameB.getBounds())
+            {
+                owner.drawAligned (frameB, alignedB, scale);
+                allTilesDirty = true;
+            }
+
+            sourceB = alignedB;
+        }
+
+        const auto& grid = owner.history.getGrid();
+        std::vector<juce::Rectangle<int>> areas;
+        if (allTilesDirty)
+        {
+            for (auto tile = 0; tile < grid.getNumTiles(); ++tile)
+                areas.push_back (grid.getTileBounds (tile));
+        }
+        else
+        {
+            std::sort (dirtyTiles.begin(), dirtyTiles.end());
+            dirtyTiles.erase (std::unique (dirtyTiles.begin(), dirtyTiles.end()), dirtyTiles.end());
+            for (auto tile : dirtyTiles)
+                areas.push_back (grid.getTileBounds (tile));
+        }
+
+        dirtyTiles.clear();
+        allTilesDirty = false;
+
+        if (areas.empty())
+            return;
+
+        if (owner.currentMode == ViewMode::Blend)
+            PixelKernels::renderBlend (frameA, sourceB, compositeImage, areas, juce::roundToInt (owner.blendAmount * 256.0f), *owner.workerPool);
+        else
+            PixelKernels::renderDifference (frameA, sourceB, compositeImage, areas, owner.differenceOptions, *owner.workerPool);
+    }
+
+    void SplitView::HistoryComponent::visibilityChanged()
+    {
+        if (!isVisible())
+        {
+            compositeImage = juce::Image();
+            alignedB = juce::Image();
+            invalidateComposite();
+        }
+    }
+
+    void SplitView::HistoryComponent::frameChanged (const std::vector<int>& changedTiles)
+    {
+        // Past a full frame's worth, the whole composite is redone anyway
+        if (dirtyTiles.size() + changedTiles.size() > (size_t) owner.history.getGrid().getNumTiles())
+            allTilesDirty = true;
+        else
+            dirtyTiles.insert (dirtyTiles.end(), changedTiles.begin(), changedTiles.end());
+
+        repaint();
+    }
+
+    void SplitView::HistoryComponent::invalidateComposite()
+    {
+        dirtyTiles.clear();
+        allTilesDirty = true;
+        repaint();
+    }
+
+    SplitView::MagnifierComponent::MagnifierComponent (SplitView& parent)
+        : owner (parent)
+    {
+        setInterceptsMouseClicks (false, false);
+        setSize (panelSize * 2 + spacing * 3, panelSize + labelHeight + spacing * 2);
+    }
+
+    void SplitView::MagnifierComponent::paint (juce::Graphics& g)
+    {
+        g.setColour (juce::Colours::black.withAlpha (0.85f));
+        g.fillRoundedRectangle (getLocalBounds().toFloat(), 4.0f);
+
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+        const auto panelArea = juce::Rectangle<int> (spacing, spacing, panelSize, panelSize + labelHeight);
+        paintPanel (g, panelArea, scale, true);
+        paintPanel (g, panelArea.translated (panelSize + spacing, 0), scale, false);
+    }
+
+    void SplitView::MagnifierComponent::paintPanel (juce::Graphics& g, juce::Rectangle<int> area, float scale, bool isFirst)
+    {
+        auto labelArea = area.removeFromBottom (labelHeight);
+        auto* wrapper = owner.getComparedWrapper (isFirst);
+        const auto snapshot = wrapper != nullptr ? wrapper->getSnapshot() : juce::Image();
+        if (snapshot.isNull() || owner.getWidth() <= 0)
+            return;
+
+        // The snapshots are at physical pixel scale
+        const auto snapshotScale = (float) snapshot.getWidth() / (float) owner.getWidth();
+        const auto panelPixels = juce::roundToInt ((float) panelSize * scale);
+
+        auto zoom = owner.magnifierZoom;
+        auto centre = juce::Point<int> ((int) std::floor (samplePosition.x * snapshotScale),
+                                        (int) std::floor (samplePosition.y * snapshotScale));
+
+        if (shownArea.has_value())
+        {
+            // As far in as the area still fits, with a pixel around it to see where it ends
+            const auto areaPixels = (*shownArea * snapshotScale).getSmallestIntegerContainer();
+            zoom = juce::jmin (maxMagnifierZoom, panelPixels / (juce::jmax (areaPixels.getWidth(), areaPixels.getHeight()) + 2));
+            centre = areaPixels.getCentre();
+
+            // Too large to magnify, so it is shrunk to fit instead
+            if (zoom < 1)
+            {
+                const auto source = areaPixels.expanded (1).getIntersection (snapshot.getBounds());
+                g.setImageResamplingQuality (juce::Graphics::mediumResamplingQuality);
+                g.drawImage (snapshot.getClippedImage (source), area.toFloat(), juce::RectanglePlacement::centred);
+                paintLabel (g, labelArea, snapshot, centre, isFirst);
+                return;
+            }
+        }
+
+        // An odd number of pixels across keeps the pixel under the mouse in the centre
+        auto pixelsAcross = juce::jmax (1, panelPixels / zoom);
+        if (pixelsAcross % 2 == 0)
+            --pixelsAcross;
+
+        const auto sourceArea = juce::Rectangle<int> (pixelsAcross, pixelsAcross).withCentre (centre);
+
+        auto& image = magnified[isFirst ? 0 : 1];
+        const auto imageSize = pixelsAcross * zoom;
+        if (image.getWidth() != imageSize || image.getHeight() != imageSize)
+            image = juce::Image (juce::Image::ARGB, imageSize, imageSize, false);
+
+        PixelKernels::magnify (snapshot, sourceArea, image, zoom);
+
+        const auto cell = (float) zoom / scale;
+        const auto imageArea = area.toFloat().withSizeKeepingCentre (cell * (float) pixelsAcross, cell * (float) pixelsAcross);
+        g.setImageResamplingQuality (juce::Graphics::lowResamplingQuality);
+        g.drawImageTransformed (image, juce::AffineTransform::scale (1.0f / scale).translated (imageArea.getX(), imageArea.getY()));
+
+        // One physical pixel wide grid lines between the magnified pixels
+        g.setColour (juce::Colours::grey.withAlpha (0.5f));
+        for (auto i = 1; i < pixelsAcross; ++i)
+        {
+            const auto offset = cell * (float) i;
+            g.fillRect (juce::Rectangle<float> (imageArea.getX() + offset, imageArea.getY(), 1.0f / scale, imageArea.getHeight()));
+            g.fillRect (juce::Rectangle<float> (imageArea.getX(), imageArea.getY() + offset, imageArea.getWidth(), 1.0f / scale));
+        }
+
+        const auto centreCell = cell * (float) (pixelsAcross / 2);
+        g.setColour (juce::Colours::white);
+        g.drawRect (juce::Rectangle<float> (imageArea.getX() + centreCell, imageArea.getY() + centreCell, cell, cell), 1.0f);
+
+        paintLabel (g, labelArea, snapshot, centre, isFirst);
+    }
+
+    void SplitView::MagnifierComponent::paintLabel (juce::Graphics& g, juce::Rectangle<int> area, const juce::Image& snapshot, juce::Point<int> centre, bool isFirst)
+    {
+        // getPixelAt() unpremultiplies, so the readout matches what the component painted
+        const auto pixel = snapshot.getBounds().contains (centre) ? snapshot.getPixelAt (centre.x, centre.y) : juce::Colours::transparentBlack;
+        const auto label = owner.panes[isFirst ? owner.comparedA : owner.comparedB]->button.getButtonText();
+        g.setColour (juce::Colours::white);
+        g.setFont ((float) labelHeight * 0.75f);
+        g.drawText (label + "  #" + pixel.toDisplayString (true), area, juce::Justification::centred);
+    }
+
+    void SplitView::MagnifierComponent::setSamplePosition (juce::Point<float> position)
+    {
+        shownArea.reset();
+        samplePosition = position;
+        moveBeside ({ position, position });
+    }
+
+    void SplitView::MagnifierComponent::showArea (juce::Rectangle<float> area)
+    {
+        shownArea = area;
+        samplePosition = area.getCentre();
+        moveBeside (area);
+    }
+
+    void SplitView::MagnifierComponent::moveBeside (juce::Rectangle<float> area)
+    {
+        // Flipped to the other side near the edges of the view, and kept inside it if neither side has room
+        constexpr auto distance = 24;
+        const auto bounds = area.getSmallestIntegerContainer();
+        auto x = bounds.getRight() + distance;
+        auto y = bounds.getBottom() + distance;
+        if (x + getWidth() > owner.getWidth())
+            x = juce::jmax (0, bounds.getX() - distance - getWidth());
+        if (y + getHeight() > owner.getHeight())
+            y = juce::jmax (0, bounds.getY() - distance - getHeight());
+
+        setTopLeftPosition (x, y);
+        repaint();
+    }
+
+    SplitView::ProfilerOverlay::ProfilerOverlay (SplitView& parent)
+        : owner (parent)
+    {
+        setInterceptsMouseClicks (false, false);
+    }
+
+    void SplitView::ProfilerOverlay::paint (juce::Graphics& g)
+    {
+        g.setColour (juce::Colours::black.withAlpha (0.7f));
+        g.fillRoundedRectangle (getLocalBounds().toFloat(), 4.0f);
+
+        g.setColour (juce::Colours::white);
+        g.setFont ((float) rowHeight * 0.75f);
+
+        auto area = getLocalBounds().reduced (6, 4);
+        g.drawText ("paint ms  p50 / p95 / max   calls   px per frame", area.removeFromTop (rowHeight), juce::Justification::centredLeft);
+
+        for (auto i = 0; i < owner.panes.size(); ++i)
+        {
+            if (!owner.panes[i]->wrapper.hasContent())
+                continue;
+
+            const auto summary = owner.profiler.getSummary (i, numFrames);
+            const auto text = owner.panes[i]->button.getButtonText() + ":  "
+                              + juce::String (summary.p50Ms, 2) + " / " + juce::String (summary.p95Ms, 2) + " / " + juce::String (summary.maxMs, 2)
+                              + "   " + juce::String (summary.callsPerFrame, 1)
+                              + "   " + juce::String (juce::roundToInt (summary.areaPerFrame));
+            g.drawText (text, area.removeFromTop (rowHeight), juce::Justification::centredLeft);
+        }
+    }
+
+    void SplitView::ProfilerOverlay::visibilityChanged()
+    {
+        // The statistics are refreshed at a low rate, as refreshing them makes the components under the overlay repaint
+        if (isVisible())
+            startTimerHz (4);
+        else
+            stopTimer();
+    }
+
+    void SplitView::ProfilerOverlay::timerCallback()
+    {
+        repaint();
+    }
+
+    SplitView::SplitView()
+        : composite (*this),
+          historyView (*this),
+          magnifier (*this),
+          profilerOverlay (*this),
+          metricsEngine ([this] {
+              DiffMetricsEngine::Frames frames;
+              auto* wrapperA = getComparedWrapper (true);
+              auto* wrapperB = getComparedWrapper (false);
+              if (wrapperA != nullptr && wrapperB != nullptr)
+              {
+                  frames.a = wrapperA->getSnapshot();
+                  frames.b = wrapperB->getSnapshot();
+                  frames.dirtyTiles = metricsTiles.takeDirtyTiles (wrapperA->getTiles(), wrapperB->getTiles());
+              }
+              return frames;
+          }),
+          regionEngine ([this] { return getRegionFrames(); }),
+          inputMirror (*this, [this] {
+              std::vector<juce::Component*> roots;
+              for (auto* pane : panes)
+                  if (pane->wrapper.hasContent())
+                      roots.push_back (pane->wrapper.getContent());
+              return roots;
+          }),
+          vBlankAttachment (this, [this] { handleVBlank(); })
+    {
+        setOpaque (false);
+        addChildComponent (composite);
+        addChildComponent (historyView);
+        addChildComponent (profilerOverlay);
+        addChildComponent (magnifier);
+
+        showBothButton.setLookAndFeel (&radioButtonLookAndFeel);
+        showDifferenceButton.setLookAndFeel (&radioButtonLookAndFeel);
+        showBlendButton.setLookAndFeel (&radioButtonLookAndFeel);
+
+        addAndMakeVisible (showBothButton);
+        addAndMakeVisible (showDifferenceButton);
+        addAndMakeVisible (showBlendButton);
+        addChildComponent (blendSlider);
+        addChildComponent (historySlider);
+
+        showBothButton.setRadioGroupId (1);
+        showDifferenceButton.setRadioGroupId (1);
+        showBlendButton.setRadioGroupId (1);
+
+        showBothButton.setToggleState (true, juce::dontSendNotification);
+
+        showBothButton.onClick = [this]() { setViewMode (ViewMode::Split); };
+        showDifferenceButton.onClick = [this]() { setViewMode (ViewMode::Difference); };
+        showBlendButton.onClick = [this]() { setViewMode (ViewMode::Blend); };
+
+        blendSlider.setRange (0.0, 1.0);
+        blendSlider.setValue (blendAmount, juce::dontSendNotification);
+        blendSlider.onValueChange = [this]() { setBlendAmount ((float) blendSlider.getValue()); };
+
+        // The slider counts frames from the oldest, so the newest is at the right
+        historySlider.setTextBoxStyle (juce::Slider::TextBoxRight, true, 70, 24);
+        historySlider.textFromValueFunction = [this] (double value) {
+            const auto newest = history.getNumFrames() - 1;
+            const auto index = juce::roundToInt (value);
+            if (index >= newest || index < 0)
+                return juce::String ("Live");
+
+            return juce::String (history.getFrameTime (index) - history.getFrameTime (newest), 3) + " s";
+        };
+        historySlider.onValueChange = [this]() { setHistoryPosition (history.getNumFrames() - 1 - juce::roundToInt (historySlider.getValue())); };
+
+        // The A and B slots always exist, even before a component is set
+        addPane ("A");
+        addPane ("B");
+
+        setViewMode (ViewMode::Split);
+
+        metricsEngine.onMetricsUpdated = [this] (const DiffMetrics& metrics) {
+            repaint (getMetricsOverlayBounds());
+            if (onMetricsUpdated)
+                onMetricsUpdated (metrics);
+        };
+
+        regionEngine.onRegionsUpdated = [this] (const std::vector<DifferenceRegion>& regions) { updateDifferenceRegions (regions); };
+
+        autoAligner.onFinished = [this] (std::optional<Alignment> result) {
+            if (result)
+                result->offset = result->offset / autoAlignScale;
+
+            if (result && result->confidence >= Alignment::minimumConfidence)
+                setAlignment (result);
+
+            if (onAutoAligned)
+                onAutoAligned (result);
+        };
+
+        addMouseListener (this, true);
+    }
+
+    SplitView::Pane& SplitView::addPane (const juce::String& label)
+    {
+        auto* pane = panes.add (new Pane (bufferPool));
+
+        pane->wrapper.onSnapshotUpdated = [this, pane] (const auto& area) { handleSnapshotUpdated (pane->wrapper, area); };
+        updatePaintHook (*pane);
+        addChildComponent (pane->wrapper);
+        pane->wrapper.toBehind (&composite);
+
+        pane->button.setButtonText (label);
+        pane->button.setLookAndFeel (&radioButtonLookAndFeel);
+        pane->button.setRadioGroupId (1);
+        pane->button.onClick = [this, pane]() { showSingleComponent (panes.indexOf (pane)); };
+        addAndMakeVisible (pane->button);
+
+        if (panes.size() > 1)
+        {
+            auto* divider = dividers.add (new DividerComponent (*this, dividers.size()));
+            divider->setStyle (dividerStyle);
+            addChildComponent (divider);
+            divider->toBehind (&magnifier);
+        }
+
+        resetDividerPositions();
+        return *pane;
+    }
+
+    void SplitView::resetDividerPositions()
+    {
+        dividerPositions.resize ((size_t) dividers.size());
+        for (size_t i = 0; i < dividerPositions.size(); ++i)
+            dividerPositions[i] = (float) (i + 1) / (float) panes.size();
+
+        // Sized here, with the dividers, so that a drag never allocates
+        pendingDividerPositions.assign (dividerPositions.size(), std::nullopt);
+    }
+
+    void SplitView::updatePaintHook (Pane& pane)
+    {
+        if (repaintHeatmapEnabled)
+            pane.wrapper.onInvalidated = [this, &pane] (juce::Rectangle<int> area) {
+                pane.repaintHeatmap.record (area, juce::Time::getMillisecondCounterHiRes() / 1000.0);
+            };
+        else
+            pane.wrapper.onInvalidated = nullptr;
+
+        if (!profilerEnabled)
+        {
+            pane.wrapper.onPainted = nullptr;
+            return;
+        }
+
+        pane.wrapper.onPainted = [this, &pane] (juce::int64 startTicks, juce::int64 endTicks, juce::Rectangle<int> area) {
+            PaintProfiler::Sample sample;
+            sample.source = panes.indexOf (&pane);
+            sample.frame = profiler.getCurrentFrame();
+            sample.startTicks = startTicks;
+            sample.endTicks = endTicks;
+            sample.area = (juce::int64) area.getWidth() * area.getHeight();
+            profiler.addSample (sample);
+        };
+    }
+
+    SplitView::ComponentWrapper* SplitView::getWrapper (int index) const
+    {
+        auto* pane = panes[index];
+        return pane != nullptr ? &pane->wrapper : nullptr;
+    }
+
+    SplitView::ComponentWrapper* SplitView::getComparedWrapper (bool first) const
+    {
+        auto* wrapper = getWrapper (first ? comparedA : comparedB);
+        return wrapper != nullptr && wrapper->hasContent() ? wrapper : nullptr;
+    }
+
+    int SplitView::getSingleComponentIndex() const
+    {
+        switch (currentMode)
+        {
+            case ViewMode::A:
+                return 0;
+            case ViewMode::B:
+                return 1;
+            case ViewMode::Single:
+                return singleComponentIndex;
+            default:
+                return -1;
+        }
+    }
+
+    void SplitView::setActiveComponent (int index)
+    {
+        if (index == activeComponentIndex)
+            return;
+
+        activeComponentIndex = index;
+        if (onActiveComponentChanged)
+            onActiveComponentChanged (index);
+    }
+
+    void SplitView::resized()
+    {
+        updateChildBounds();
+
+        if (currentMode == ViewMode::Split)
+            updateClipBounds();
+
+        repaint();
+    }
+
+    void SplitView::visibilityChanged()
+    {
+        if (!isVisible())
+            bufferPool.releaseUnused();
+    }
+
+    void SplitView::paintOverChildren (juce::Graphics& g)
+    {
+        // Every component painted in this pass has painted by now
+        if (profilerEnabled)
+            profiler.endFrame();
+
+        repaintedSinceRecordedFrame = true;
+
+        if (repaintHeatmapEnabled)
+            paintRepaintHeatmap (g);
+
+        if (differenceRegionsEnabled && getSingleComponentIndex() < 0 && historyPosition == 0)
+            paintDifferenceRegions (g);
+
+        if (metricsEnabled)
+            paintMetricsOverlay (g);
+
+        if (currentMode != ViewMode::Split)
+        {
+            return;
+        }
+
+        for (auto* divider : dividers)
+        {
+            if (!divider->isVisible())
+                continue;
+
+            const auto dividerBounds = divider->getBounds();
+            const auto centerX = dividerBounds.getCentreX();
+            const auto centerY = dividerBounds.getCentreY();
+
+            constexpr auto circleRadius = dividerHandleRadius;
+            const juce::Rectangle circleBounds(centerX - circleRadius,
+                                               centerY - circleRadius,
+                                               circleRadius * 2,
+                                               circleRadius * 2);
+
+            const auto currentStyle = divider->getStyle();
+            const auto bgColour = (currentStyle == Style::Light)
+                            ? juce::Colours::darkgrey.withAlpha(0.8f)
+                            : juce::Colours::lightgrey.withAlpha(0.8f);
+            const auto arrowColour = (currentStyle == Style::Light)
+                               ? juce::Colours::white
+                               : juce::Colours::black;
+
+            g.setColour(bgColour);
+            g.fillEllipse(circleBounds);
+
+            g.setColour(arrowColour);
+
+            constexpr auto arrowSize = 5.0f;
+            constexpr auto spacing = 6.0f;
+            constexpr auto lineThickness = 2.0f;
+
+            // The arrows point across the divider
+            const auto arrowTransform = juce::AffineTransform::rotation (juce::degreesToRadians (getDividerAngle()),
+                                                                         (float) centerX, (float) centerY);
+
+            juce::Path leftArrow;
+            leftArrow.startNewSubPath(centerX - spacing, centerY - arrowSize);
+            leftArrow.lineTo(centerX - spacing - arrowSize, centerY);
+            leftArrow.lineTo(centerX - spacing, centerY + arrowSize);
+            g.strokePath(leftArrow, juce::PathStrokeType(lineThickness, 
+                                                         juce::PathStrokeType::mitered,
+                                                         juce::PathStrokeType::rounded), arrowTransform);
+
+            juce::Path rightArrow;
+            rightArrow.startNewSubPath(centerX + spacing, centerY - arrowSize);
+            rightArrow.lineTo(centerX + spacing + arrowSize, centerY);
+            rightArrow.lineTo(centerX + spacing, centerY + arrowSize);
+            g.strokePath(rightArrow, juce::PathStrokeType(lineThickness, 
+                                                          juce::PathStrokeType::mitered,
+                                                          juce::PathStrokeType::rounded), arrowTransform);
+        }
+    }
+
+    void SplitView::paintMetricsOverlay (juce::Graphics& g)
+    {
+        const auto& metrics = metricsEngine.getLatestMetrics();
+        if (!metrics)
+            return;
+
+        const auto changedPercent = metrics->totalPixels > 0
+                                        ? 100.0 * (double) metrics->changedPixels / (double) metrics->totalPixels
+                                        : 0.0;
+        const auto psnrText = std::isfinite (metrics->psnr) ? juce::String (metrics->psnr, 1) + " dB" : juce::String ("inf");
+        const auto text = "Changed " + juce::String (metrics->changedPixels) + " px (" + juce::String (changedPercent, 2) + "%)"
+                          + "   Max delta " + juce::String (metrics->maxChannelDelta)
+                          + "   PSNR " + psnrText
+                          + "   SSIM " + juce::String (metrics->ssim, 4);
+
+        const auto bounds = getMetricsOverlayBounds().toFloat();
+        const auto currentStyle = dividerStyle;
+        g.setColour ((currentStyle == Style::Light) ? juce::Colours::darkgrey.withAlpha (0.8f)
+                                                    : juce::Colours::lightgrey.withAlpha (0.8f));
+        g.fillRoundedRectangle (bounds, bounds.getHeight() * 0.2f);
+
+        g.setColour ((currentStyle == Style::Light) ? juce::Colours::white : juce::Colours::black);
+        g.setFont (bounds.getHeight() * 0.6f);
+        g.drawText (text, bounds, juce::Justification::centred);
+    }
+
+    void SplitView::paintDifferenceRegions (juce::Graphics& g)
+    {
+        for (auto i = 0; i < (int) differenceRegions.size(); ++i)
+        {
+            const auto outline = getDifferenceRegionOutline (i);
+            if (!g.clipRegionIntersects (outline.getSmallestIntegerContainer().expanded (1)))
+                continue;
+
+            const auto isSelected = i == selectedDifferenceRegion;
+            g.setColour (isSelected ? juce::Colours::yellow : juce::Colours::orange.withAlpha (0.8f));
+            g.drawRect (outline, isSelected ? 2.0f : 1.0f);
+        }
+    }
+
+    juce::Rectangle<float> SplitView::getDifferenceRegionOutline (int index) const
+    {
+        return differenceRegions[(size_t) index].expanded (differenceRegionMargin);
+    }
+
+    DifferenceRegionEngine::Frames SplitView::getRegionFrames()
+    {
+        DifferenceRegionEngine::Frames frames;
+        auto* wrapperA = getComparedWrapper (true);
+        auto* wrapperB = getComparedWrapper (false);
+        if (wrapperA == nullptr || wrapperB == nullptr || getWidth() <= 0)
+            return frames;
+
+        frames.a = wrapperA->getSnapshot();
+        frames.b = wrapperB->getSnapshot();
+        frames.dirtyTiles = regionTiles.takeDirtyTiles (wrapperA->getTiles(), wrapperB->getTiles());
+        regionScale = (float) frames.a.getWidth() / (float) getWidth();
+
+        // Labelled against B as the view shows it, so the outlines match once it is aligned
+        if (alignment.has_value() && frames.b.isValid())
+        {
+            // B moves as a whole, so a change anywhere in it can land in any tile. No labelling
+            // is running while the frames are provided, so regionAlignedB can be drawn into.
+            if (!frames.dirtyTiles.empty() || regionAlignedB.getBounds() != frames.b.getBounds())
+            {
+                drawAligned (frames.b, regionAlignedB, regionScale);
+                frames.dirtyTiles.resize ((size_t) wrapperA->getTiles().getGrid().getNumTiles());
+                std::iota (frames.dirtyTiles.begin(), frames.dirtyTiles.end(), 0);
+            }
+
+            frames.b = regionAlignedB;
+        }
+
+        return frames;
+    }
+
+    void SplitView::drawAligned (const juce::Image& source, juce::Image& dest, float scale) const
+    {
+        jassert (alignment.has_value());
+
+        if (dest.getBounds() != source.getBounds())
+            dest = juce::Image (juce::Image::ARGB, source.getWidth(), source.getHeight(), true);
+        else
+            dest.clear (dest.getBounds());
+
+        // The alignment is in points, the snapshots in physical pixels
+        juce::Graphics imageContext (dest);
+        imageContext.drawImageTransformed (source,
+            juce::AffineTransform::scale (1.0f / scale)
+                .followedBy (alignment->getTransform())
+                .followedBy (juce::AffineTransform::scale (scale)));
+    }
+
+    void SplitView::repaintDifferenceRegions()
+    {
+        // Past this many, one repaint of everything is cheaper than collecting the outlines
+        constexpr auto maxOutlinesToRepaint = 64;
+        if ((int) differenceRegions.size() > maxOutlinesToRepaint)
+        {
+            repaint();
+            return;
+        }
+
+        for (auto i = 0; i < (int) differenceRegions.size(); ++i)
+            repaint (getDifferenceRegionOutline (i).getSmallestIntegerContainer().expanded (1));
+    }
+
+    void SplitView::updateDifferenceRegions (const std::vector<DifferenceRegion>& regions)
+    {
+        const auto selected = juce::isPositiveAndBelow (selectedDifferenceRegion, (int) differenceRegions.size())
+                                  ? std::optional<juce::Rectangle<float>> (differenceRegions[(size_t) selectedDifferenceRegion])
+                                  : std::nullopt;
+
+        repaintDifferenceRegions();
+
+        differenceRegions.clear();
+        for (const auto& region : regions)
+            differenceRegions.push_back (region.bounds.toFloat() / regionScale);
+
+        // The selection follows its region while it changes, e.g. as it animates
+        selectedDifferenceRegion = -1;
+        for (auto i = 0; selected && i < (int) differenceRegions.size(); ++i)
+        {
+            if (differenceRegions[(size_t) i].intersects (*selected))
+            {
+                selectedDifferenceRegion = i;
+                break;
+            }
+        }
+
+        repaintDifferenceRegions();
+
+        if (onDifferenceRegionsUpdated)
+            onDifferenceRegionsUpdated (differenceRegions);
+    }
+
+    juce::Rectangle<int> SplitView::getMetricsOverlayBounds() const
+    {
+        const int overlayHeight = 22;
+        const int overlayWidth = juce::jmin (getWidth() - 10, 480);
+        const int bottom = historyEnabled ? getHistorySliderBounds().getY() : getHeight();
+        return { (getWidth() - overlayWidth) / 2, bottom - overlayHeight - 5, overlayWidth, overlayHeight };
+    }
+
+    juce::Rectangle<int> SplitView::getHistorySliderBounds() const
+    {
+        const int sliderHeight = 24;
+        const int sliderWidth = juce::jmin (getWidth() - 10, 480);
+        return { (getWidth() - sliderWidth) / 2, getHeight() - sliderHeight - 5, sliderWidth, sliderHeight };
+    }
+
+    void SplitView::paintRepaintHeatmap (juce::Graphics& g)
+    {
+        juce::String text ("Invalidated px/s");
+        for (auto i = 0; i < panes.size(); ++i)
+        {
+            auto& pane = *panes[i];
+            if (!pane.wrapper.hasContent())
+                continue;
+
+            const auto pixelsPerSecond = pane.repaintHeatmap.getPixelsPerSecond (juce::Time::getMillisecondCounterHiRes() / 1000.0);
+            text += "   " + pane.button.getButtonText() + " " + juce::String (pixelsPerSecond / 1.0e6, 2) + "M";
+
+            if (!pane.wrapper.isVisible())
+                continue;
+
+            // Each side's heat is only drawn over the part of the view that shows it
+            juce::Graphics::ScopedSaveState state (g);
+            if (currentMode != ViewMode::Split || getPaneRegion (i).reduceClipRegion (g))
+                pane.repaintHeatmap.paint (g, i == comparedB ? juce::Colours::orange : juce::Colours::red);
+        }
+
+        const auto bounds = getRepaintHeatmapLabelBounds().toFloat();
+        g.setColour (juce::Colours::black.withAlpha (0.7f));
+        g.fillRoundedRectangle (bounds, 4.0f);
+        g.setColour (juce::Colours::white);
+        g.setFont (bounds.getHeight() * 0.6f);
+        g.drawText (text, bounds.reduced (6.0f, 0.0f), juce::Justification::centredLeft);
+    }
+
+    juce::Rectangle<int> SplitView::getRepaintHeatmapLabelBounds() const
+    {
+        const int labelWidth = juce::jmin (getWidth() - 10, 320);
+        return { getWidth() - labelWidth - 5, 63, labelWidth, 22 };
+    }
+
+    void SplitView::updateRepaintHeatmap()
+    {
+        const auto now = juce::Time::getMillisecondCounterHiRes() / 1000.0;
+        if (now - lastHeatmapUpdate < 0.1)
+            return;
+
+        lastHeatmapUpdate = now;
+
+        // Cells that cool down must be repainted too, so the warm areas are taken before decaying
+        for (auto* pane : panes)
+        {
+            repaint (pane->repaintHeatmap.getWarmArea());
+            pane->repaintHeatmap.decay (now);
+        }
+
+        repaint (getRepaintHeatmapLabelBounds());
+    }
+
+    void SplitView::setRepaintHeatmapEnabled (bool shouldShowHeatmap)
+    {
+        if (repaintHeatmapEnabled == shouldShowHeatmap)
+            return;
+
+        repaintHeatmapEnabled = shouldShowHeatmap;
+        for (auto* pane : panes)
+        {
+            pane->repaintHeatmap.clear();
+            updatePaintHook (*pane);
+        }
+
+        setViewMode (currentMode);
+    }
+
+    double SplitView::getInvalidatedPixelsPerSecond (int componentIndex)
+    {
+        if (!juce::isPositiveAndBelow (componentIndex, panes.size()))
+            return 0.0;
+
+        return panes[componentIndex]->repaintHeatmap.getPixelsPerSecond (juce::Time::getMillisecondCounterHiRes() / 1000.0);
+    }
+
+    void SplitView::setMetricsEnabled (bool shouldShowMetrics)
+    {
+        if (metricsEnabled == shouldShowMetrics)
+            return;
+
+        metricsEnabled = shouldShowMetrics;
+        if (metricsEnabled)
+            metricsEngine.markDirty();
+        else
+            metricsEngine.cancel();
+
+        setViewMode (currentMode);
+    }
+
+    void SplitView::setDifferenceRegionsEnabled (bool shouldShowRegions)
+    {
+        if (differenceRegionsEnabled == shouldShowRegions)
+            return;
+
+        differenceRegionsEnabled = shouldShowRegions;
+        setWantsKeyboardFocus (differenceRegionsEnabled);
+
+        if (differenceRegionsEnabled)
+        {
+            regionEngine.markDirty();
+        }
+        else
+        {
+            regionEngine.cancel();
+            updateDifferenceRegions ({});
+        }
+
+        setViewMode (currentMode);
+    }
+
+    void SplitView::showDifferenceRegion (int index)
+    {
+        if (!juce::isPositiveAndBelow (index, (int) differenceRegions.size()))
+            index = -1;
+
+        repaintDifferenceRegions();
+        selectedDifferenceRegion = index;
+        if (index < 0)
+            return;
+
+        const auto region = differenceRegions[(size_t) index];
+
+        // Half of the region then shows each side
+        if (std::abs (comparedA - comparedB) == 1)
+            setDividerPosition (juce::jmin (comparedA, comparedB), dividerGeometry.getProportionAt (region.getCentre()));
+
+        if (magnifierEnabled && getSingleComponentIndex() < 0 && historyPosition == 0)
+        {
+            magnifier.showArea (region);
+            magnifier.setVisible (true);
+        }
+    }
+
+    void SplitView::showNextDifferenceRegion()
+    {
+        const auto numRegions = (int) differenceRegions.size();
+        if (numRegions > 0)
+            showDifferenceRegion ((selectedDifferenceRegion + 1) % numRegions);
+    }
+
+    void SplitView::showPreviousDifferenceRegion()
+    {
+        const auto numRegions = (int) differenceRegions.size();
+        if (numRegions > 0)
+            showDifferenceRegion (selectedDifferenceRegion <= 0 ? numRegions - 1 : selectedDifferenceRegion - 1);
+    }
+
+    void SplitView::setDifferenceRegionKeys (const juce::KeyPress& nextKey, const juce::KeyPress& previousKey)
+    {
+        nextDifferenceRegionKey = nextKey;
+        previousDifferenceRegionKey = previousKey;
+    }
+
+    bool SplitView::keyPressed (const juce::KeyPress& key)
+    {
+        // Keys the components inside don't use come up here
+        if (!differenceRegionsEnabled || historyPosition > 0)
+            return false;
+
+        if (key == nextDifferenceRegionKey)
+            showNextDifferenceRegion();
+        else if (key == previousDifferenceRegionKey)
+            showPreviousDifferenceRegion();
+        else
+            return false;
+
+        return true;
+    }
+
+    void SplitView::setMagnifierEnabled (bool shouldShowMagnifier)
+    {
+        if (magnifierEnabled == shouldShowMagnifier)
+            return;
+
+        magnifierEnabled = shouldShowMagnifier;
+        if (!magnifierEnabled)
+            magnifier.setVisible (false);
+
+        setViewMode (currentMode);
+    }
+
+    void SplitView::setMagnifierZoom (int zoom)
+    {
+        magnifierZoom = juce::jlimit (minMagnifierZoom, maxMagnifierZoom, zoom);
+        magnifier.repaint();
+    }
+
+    void SplitView::setProfilerEnabled (bool shouldProfile)
+    {
+        if (profilerEnabled == shouldProfile)
+            return;
+
+        profilerEnabled = shouldProfile;
+        for (auto* pane : panes)
+            updatePaintHook (*pane);
+
+        profilerOverlay.setVisible (profilerEnabled);
+        resized();
+    }
+
+    juce::StringArray SplitView::getComponentLabels() const
+    {
+        juce::StringArray labels;
+        for (auto* pane : panes)
+            labels.add (pane->button.getButtonText());
+        return labels;
+    }
+
+    bool SplitView::startRecording (const juce::File& directory, FrameRecorder::Format format, int framesPerSecond)
+    {
+        lastRecordedFrame = {};
+        const auto started = recorder.start (directory, format, framesPerSecond, [this] {
+            // An unchanged view is recorded as the same image, which the recorder doesn't encode again
+            if (!repaintedSinceRecordedFrame && lastRecordedFrame.isValid())
+                return lastRecordedFrame;
+
+            lastRecordedFrame = createComponentSnapshot (getLocalBounds(), true, juce::Component::getApproximateScaleFactorForComponent (this));
+            repaintedSinceRecordedFrame = false;
+            return lastRecordedFrame;
+        });
+
+        setViewMode (currentMode);
+        return started;
+    }
+
+    void SplitView::stopRecording()
+    {
+        recorder.stop();
+        lastRecordedFrame = {};
+        setViewMode (currentMode);
+    }
+
+    void SplitView::setHistoryEnabled (bool shouldKeepHistory)
+    {
+        if (historyEnabled == shouldKeepHistory)
+            return;
+
+        historyEnabled = shouldKeepHistory;
+        history.clear();
+        historyPosition = 0;
+        historyDirty = historyEnabled;
+
+        historySlider.setVisible (historyEnabled);
+        updateHistorySlider();
+        setViewMode (currentMode);
+    }
+
+    void SplitView::setHistoryPosition (int framesBack)
+    {
+        framesBack = historyEnabled ? juce::jlimit (0, juce::jmax (0, history.getNumFrames() - 1), framesBack) : 0;
+        if (framesBack == historyPosition)
+            return;
+
+        const auto wasLive = historyPosition == 0;
+        historyPosition = framesBack;
+
+        if (historyPosition > 0)
+            historyView.frameChanged (history.decode (history.getNumFrames() - 1 - historyPosition, *workerPool));
+
+        updateHistorySlider();
+
+        if (wasLive != (historyPosition == 0))
+            setViewMode (currentMode);
+    }
+
+    void SplitView::captureHistoryFrame()
+    {
+        historyDirty = false;
+
+        auto* wrapperA = getComparedWrapper (true);
+        auto* wrapperB = getComparedWrapper (false);
+        if (wrapperA == nullptr || wrapperB == nullptr)
+            return;
+
+        const auto snapshotA = wrapperA->getSnapshot();
+        const auto snapshotB = wrapperB->getSnapshot();
+        if (snapshotA.isNull() || snapshotB.isNull())
+            return;
+
+        if (history.push (snapshotA, wrapperA->getTiles(), snapshotB, wrapperB->getTiles(), juce::Time::getMillisecondCounterHiRes() / 1000.0, *workerPool))
+            updateHistorySlider();
     }
 
-    void SplitView::ComponentWrapper::resized()
+    void SplitView::updateHistorySlider()
     {
-        if (content)
-            content->setBounds (getLocalBounds());
+        const auto numFrames = history.getNumFrames();
+        historySlider.setEnabled (numFrames > 1);
+        historySlider.setRange (0.0, (double) juce::jmax (1, numFrames - 1), 1.0);
+        historySlider.setValue ((double) (numFrames - 1 - historyPosition), juce::dontSendNotification);
+        historySlider.updateText();
     }
 
-    SplitView::DividerComponent::DividerComponent (SplitView& parent)
-        : owner (parent)
+    void SplitView::autoAlign()
     {
-        setMouseCursor (juce::MouseCursor::LeftRightResizeCursor);
+        auto* wrapperA = getComparedWrapper (true);
+        auto* wrapperB = getComparedWrapper (false);
+        if (wrapperA == nullptr || wrapperB == nullptr || getWidth() <= 0)
+            return;
+
+        // Only some modes keep snapshots; otherwise both sides are rendered once for this
+        const auto scale = juce::Component::getApproximateScaleFactorForComponent (this);
+        const auto getImage = [scale] (ComponentWrapper& wrapper) {
+            auto snapshot = wrapper.getSnapshot();
+            return snapshot.isValid() ? snapshot : wrapper.getContent()->createComponentSnapshot (wrapper.getContent()->getLocalBounds(), true, scale);
+        };
+
+        const auto imageA = getImage (*wrapperA);
+        autoAlignScale = (float) imageA.getWidth() / (float) getWidth();
+        autoAligner.start (imageA, getImage (*wrapperB));
     }
 
-    void SplitView::DividerComponent::paint (juce::Graphics& g)
+    void SplitView::setAlignment (const std::optional<Alignment>& newAlignment)
     {
-        auto colour = (currentStyle == Style::Light) ? juce::Colours::white : juce::Colours::black;
-        g.setColour (colour.withAlpha (0.5f));
-        g.fillAll();
+        alignment = newAlignment;
+        updateAlignment();
     }
 
-    void SplitView::DividerComponent::mouseDown (const juce::MouseEvent&)
+    void SplitView::updateAlignment()
     {
-        isDragging = true;
+        for (auto i = 0; i < panes.size(); ++i)
+            panes[i]->wrapper.setContentTransform (i == comparedB && alignment.has_value() ? alignment->getTransform() : juce::AffineTransform());
+
+        composite.invalidateComposite();
+        historyView.invalidateComposite();
+
+        // The regions are labelled against B as it is shown
+        regionAlignedB = juce::Image();
+        regionTiles.reset();
+        if (differenceRegionsEnabled)
+            regionEngine.markDirty();
+
+        repaint();
     }
 
-    void SplitView::DividerComponent::mouseDrag (const juce::MouseEvent& e)
+    void SplitView::updateMagnifier (juce::Point<float> position)
     {
-        if (isDragging)
+        const auto shouldShow = magnifierEnabled && getSingleComponentIndex() < 0 && historyPosition == 0 && getLocalBounds().toFloat().contains (position);
+        if (shouldShow)
+            magnifier.setSamplePosition (position);
+
+        magnifier.setVisible (shouldShow);
+    }
+
+    SplitView::RenderingMode SplitView::getSplitRenderingMode() const
+    {
+        // The metrics, the difference regions, the magnifier, the history and the recorder read the snapshots
+        return metricsEnabled || differenceRegionsEnabled || magnifierEnabled || historyEnabled || recorder.isRecording()
+                   ? RenderingMode::Snapshot
+                   : renderingMode;
+    }
+
+    void SplitView::handleSnapshotUpdated (ComponentWrapper& wrapper, const juce::RectangleList<int>& updatedArea)
+    {
+        // Every consumer of the snapshots works from the tiles whose hash changed
+        wrapper.getTiles().update (wrapper.getSnapshot(), updatedArea, *workerPool);
+
+        if (metricsEnabled)
+            metricsEngine.markDirty();
+
+        if (differenceRegionsEnabled)
+            regionEngine.markDirty();
+
+        if (historyEnabled && (&wrapper == getComparedWrapper (true) || &wrapper == getComparedWrapper (false)))
+            historyDirty = true;
+
+        if (magnifier.isVisible())
+            magnifier.repaint();
+    }
+
+    void SplitView::setDividerPosition (int dividerIndex, float proportion)
+    {
+        if (!juce::isPositiveAndBelow (dividerIndex, (int) dividerPositions.size()))
         {
-            auto xPos = e.getEventRelativeTo (&owner).position.x;
-            owner.setDividerPosition (xPos);
+            jassertfalse;
+            return;
         }
+
+        // Dividers can't cross their neighbours, but can meet them
+        const auto index = (size_t) dividerIndex;
+        const auto lower = index > 0 ? dividerPositions[index - 1] : 0.01f;
+        const auto upper = index + 1 < dividerPositions.size() ? dividerPositions[index + 1] : 0.99f;
+
+        const auto oldOffset = getDividerOffset (dividerIndex);
+        dividerPositions[index] = juce::jlimit (lower, upper, proportion);
+
+        updateClipBounds();
+        updateDividerBounds();
+
+        // Only the strip swept by the divider and its handle changes on screen
+        repaint (getDividerRepaintArea (oldOffset, getDividerOffset (dividerIndex)));
     }
 
-    void SplitView::DividerComponent::setStyle (Style style)
+    void SplitView::moveDividerOnNextFrame (int dividerIndex, float proportion)
     {
-        currentStyle = style;
+        // Without a window there are no display refreshes to wait for
+        if (getPeer() == nullptr)
+        {
+            setDividerPosition (dividerIndex, proportion);
+            return;
+        }
+
+        // Mice and trackpads can report several drags per frame; only the latest counts
+        if (juce::isPositiveAndBelow (dividerIndex, (int) pendingDividerPositions.size()))
+            pendingDividerPositions[(size_t) dividerIndex] = proportion;
     }
 
-    SplitView::SplitView()
-        : divider (*this)
+    void SplitView::handleVBlank()
     {
-        setOpaque (false);
-        addAndMakeVisible (divider);
+        if (repaintHeatmapEnabled)
+            updateRepaintHeatmap();
 
-        showLeftButton.setLookAndFeel (&radioButtonLookAndFeel);
-        showRightButton.setLookAndFeel (&radioButtonLookAndFeel);
-        showBothButton.setLookAndFeel (&radioButtonLookAndFeel);
+        for (size_t i = 0; i < pendingDividerPositions.size(); ++i)
+            if (const auto proportion = std::exchange (pendingDividerPositions[i], std::nullopt))
+                setDividerPosition ((int) i, *proportion);
 
-        addAndMakeVisible (showLeftButton);
-        addAndMakeVisible (showRightButton);
-        addAndMakeVisible (showBothButton);
+        // At most one frame per refresh, after the paint that updated the snapshots
+        if (historyDirty && historyPosition == 0)
+            captureHistoryFrame();
 
-        showBothButton.setRadioGroupId (1);
-        showLeftButton.setRadioGroupId (1);
-        showRightButton.setRadioGroupId (1);
+        if (maxCompositeRate <= 0.0 || !composite.isVisible())
+            return;
 
-        showBothButton.setToggleState (true, juce::dontSendNotification);
+        const auto now = juce::Time::getMillisecondCounterHiRes();
+        if (now - lastCompositeTime < 1000.0 / maxCompositeRate)
+            return;
 
-        showLeftButton.onClick = [this]() { setViewMode (ViewMode::A); };
-        showRightButton.onClick = [this]() { setViewMode (ViewMode::B); };
-        showBothButton.onClick = [this]() { setViewMode (ViewMode::Split); };
+        auto hasHeldRepaint = false;
+        for (auto* pane : panes)
+            hasHeldRepaint = pane->wrapper.takeHeldRepaint() || hasHeldRepaint;
 
-        setViewMode (ViewMode::Split);
+        // The wrappers sit under the composite, so repainting it brings their snapshots up to date first
+        if (hasHeldRepaint)
+        {
+            composite.repaint();
+            lastCompositeTime = now;
+        }
+    }
 
-        addMouseListener (this, true);
+    void SplitView::setMaxCompositeRate (double framesPerSecond)
+    {
+        maxCompositeRate = juce::jmax (0.0, framesPerSecond);
+        setViewMode (currentMode);
     }
 
-    void SplitView::resized()
+    float SplitView::getDividerPosition (int dividerIndex) const
     {
-        updateChildBounds();
+        return juce::isPositiveAndBelow (dividerIndex, (int) dividerPositions.size()) ? dividerPositions[(size_t) dividerIndex] : 0.0f;
+    }
 
-        if (currentMode == ViewMode::Split)
-        {
-            auto divX = (int) getDividerX();
-            if (leftWrapper && leftEffect)
-                leftEffect->updateBounds (getLocalBounds().withRight (divX));
+    juce::Rectangle<int> SplitView::getDividerRepaintArea (float oldOffset, float newOffset) const
+    {
+        const auto margin = juce::jmax (dividerHandleRadius, DividerComponent::width) + 2.0f;
+        const auto area = dividerGeometry.getRegion (juce::jmin (oldOffset, newOffset) - margin,
+                                                     juce::jmax (oldOffset, newOffset) + margin);
+        return area.bounds.expanded (1).getIntersection (getLocalBounds());
+    }
 
-            if (rightWrapper && rightEffect)
-                rightEffect->updateBounds (getLocalBounds().withLeft (divX));
-        }
+    void SplitView::setDividerOrientation (DividerOrientation orientation)
+    {
+        setDividerAngle (orientation == DividerOrientation::Vertical ? 0.0f : 90.0f);
+    }
 
-        repaint();
+    void SplitView::setDividerAngle (float degrees)
+    {
+        dividerGeometry.setAngle (degrees);
+
+        for (auto* divider : dividers)
+            divider->updateMouseCursor();
+
+        updateChildBounds();
+        setViewMode (currentMode);
     }
 
-    void SplitView::paintOverChildren (juce::Graphics& g)
+    void SplitView::updateClipBounds()
     {
         if (currentMode != ViewMode::Split)
-        {
             return;
+
+        for (auto i = 0; i < panes.size(); ++i)
+        {
+            auto& wrapper = panes[i]->wrapper;
+            const auto region = getPaneRegion (i);
+            wrapper.updateClipRegion (region);
+
+            // Panes squeezed to nothing are skipped entirely when painting
+            const auto shouldBeVisible = wrapper.hasContent() && !region.isEmpty();
+            if (wrapper.isVisible() != shouldBeVisible)
+            {
+                if (shouldBeVisible)
+                    wrapper.setBounds (getLocalBounds());
+
+                wrapper.setVisible (shouldBeVisible);
+                wrapper.setEnabled (shouldBeVisible);
+            }
         }
 
-        const auto dividerBounds = divider.getBounds();
-        const auto centerX = dividerBounds.getCentreX();
-        const auto centerY = dividerBounds.getCentreY();
-
-        constexpr auto circleRadius = 16.0f;
-        const juce::Rectangle circleBounds(centerX - circleRadius,
-                                           centerY - circleRadius,
-                                           circleRadius * 2,
-                                           circleRadius * 2);
-
-        const auto currentStyle = divider.getStyle();
-        const auto bgColour = (currentStyle == Style::Light)
-                        ? juce::Colours::darkgrey.withAlpha(0.8f)
-                        : juce::Colours::lightgrey.withAlpha(0.8f);
-        const auto arrowColour = (currentStyle == Style::Light)
-                           ? juce::Colours::white
-                           : juce::Colours::black;
-
-        g.setColour(bgColour);
-        g.fillEllipse(circleBounds);
-
-        g.setColour(arrowColour);
-
-        constexpr auto arrowSize = 5.0f;
-        constexpr auto spacing = 6.0f;
-        constexpr auto lineThickness = 2.0f;
-        
-        juce::Path leftArrow;
-        leftArrow.startNewSubPath(centerX - spacing, centerY - arrowSize);
-        leftArrow.lineTo(centerX - spacing - arrowSize, centerY);
-        leftArrow.lineTo(centerX - spacing, centerY + arrowSize);
-        g.strokePath(leftArrow, juce::PathStrokeType(lineThickness, 
-                                                     juce::PathStrokeType::mitered,
-                                                     juce::PathStrokeType::rounded));
-        
-        juce::Path rightArrow;
-        rightArrow.startNewSubPath(centerX + spacing, centerY - arrowSize);
-        rightArrow.lineTo(centerX + spacing + arrowSize, centerY);
-        rightArrow.lineTo(centerX + spacing, centerY + arrowSize);
-        g.strokePath(rightArrow, juce::PathStrokeType(lineThickness, 
-                                                      juce::PathStrokeType::mitered,
-                                                      juce::PathStrokeType::rounded));
-    }
-
-    void SplitView::setDividerPosition (float xPos)
-    {
-        dividerPosition = juce::jlimit (0.01f, 0.99f, xPos / static_cast<float> (getWidth()));
-
-        auto divX = (int) getDividerX();
-        if (leftEffect)
-            leftEffect->updateBounds (getLocalBounds().withRight (divX));
-        if (rightEffect)
-            rightEffect->updateBounds (getLocalBounds().withLeft (divX));
-        updateDividerBounds();
-        repaint();
+        updateSuspension();
+    }
+
+    void SplitView::updateSuspension()
+    {
+        for (auto* pane : panes)
+            pane->wrapper.setSuspended (suspendHiddenComponents && !pane->wrapper.isVisible());
+    }
+
+    void SplitView::setSuspendHiddenComponents (bool shouldSuspend)
+    {
+        suspendHiddenComponents = shouldSuspend;
+        updateSuspension();
     }
 
-    float SplitView::getDividerX() const
+    float SplitView::getDividerOffset (int dividerIndex) const
     {
-        return dividerPosition * static_cast<float> (getWidth());
+        return dividerGeometry.getOffset (getDividerPosition (dividerIndex));
+    }
+
+    ClipRegion SplitView::getPaneRegion (int index) const
+    {
+        const auto lower = index > 0 ? std::optional<float> (getDividerOffset (index - 1)) : std::nullopt;
+        const auto upper = index < dividers.size() ? std::optional<float> (getDividerOffset (index)) : std::nullopt;
+        return dividerGeometry.getRegion (lower, upper);
     }
 
     void SplitView::setButtonText (ViewMode mode, const juce::String& text)
@@ -182,63 +1514,248 @@ namespace BogrenDigital
         switch (mode)
         {
             case ViewMode::A:
-                showLeftButton.setButtonText (text);
+                setButtonText (0, text);
                 break;
             case ViewMode::B:
-                showRightButton.setButtonText (text);
+                setButtonText (1, text);
                 break;
             case ViewMode::Split:
                 showBothButton.setButtonText (text);
                 break;
+            case ViewMode::Difference:
+                showDifferenceButton.setButtonText (text);
+                break;
+            case ViewMode::Blend:
+                showBlendButton.setButtonText (text);
+                break;
+            case ViewMode::Single:
+                setButtonText (singleComponentIndex, text);
+                break;
         }
     }
 
+    void SplitView::setButtonText (int componentIndex, const juce::String& text)
+    {
+        if (auto* pane = panes[componentIndex])
+            pane->button.setButtonText (text);
+    }
+
     void SplitView::setButtonStyle (Style style)
     {
         radioButtonLookAndFeel.setStyle (style);
-        showLeftButton.repaint();
-        showRightButton.repaint();
+        for (auto* pane : panes)
+            pane->button.repaint();
         showBothButton.repaint();
+        showDifferenceButton.repaint();
+        showBlendButton.repaint();
     }
 
     void SplitView::setDividerStyle (Style style)
     {
-        divider.setStyle (style);
-        divider.repaint();
+        dividerStyle = style;
+        for (auto* divider : dividers)
+        {
+            divider->setStyle (style);
+            divider->repaint();
+        }
     }
 
     void SplitView::setDisplayedComponent (juce::Component* component, bool isLeft)
     {
-        auto& wrapper = isLeft ? leftWrapper : rightWrapper;
-        if (!wrapper)
+        auto& pane = *panes[isLeft ? 0 : 1];
+        pane.wrapper.setContent (component);
+
+        if (pane.ownedContent.get() != component)
+            pane.ownedContent.reset();
+
+        updateChildBounds();
+        setViewMode (currentMode);
+    }
+
+    ReferenceImageComponent& SplitView::setDisplayedImage (const juce::File& imageFile, bool isLeft)
+    {
+        auto& pane = *panes[isLeft ? 0 : 1];
+        if (auto* referenceImage = dynamic_cast<ReferenceImageComponent*> (pane.ownedContent.get()))
+        {
+            referenceImage->setFile (imageFile);
+            return *referenceImage;
+        }
+
+        auto referenceImage = std::make_unique<ReferenceImageComponent> (imageFile);
+        auto& result = *referenceImage;
+        setDisplayedComponent (referenceImage.get(), isLeft);
+        pane.ownedContent = std::move (referenceImage);
+        return result;
+    }
+
+    SharedFrameComponent& SplitView::setDisplayedSharedFrames (const juce::String& channelName, bool isLeft)
+    {
+        auto& pane = *panes[isLeft ? 0 : 1];
+        if (auto* sharedFrames = dynamic_cast<SharedFrameComponent*> (pane.ownedContent.get()))
+        {
+            sharedFrames->setChannel (channelName);
+            return *sharedFrames;
+        }
+
+        auto sharedFrames = std::make_unique<SharedFrameComponent> (channelName);
+        auto& result = *sharedFrames;
+        setDisplayedComponent (sharedFrames.get(), isLeft);
+        pane.ownedContent = std::move (sharedFrames);
+        return result;
+    }
+
+    int SplitView::addDisplayedComponent (juce::Component* component, const juce::String& label)
+    {
+        auto index = -1;
+        if (panes.size() == 2)
+        {
+            if (!panes[0]->wrapper.hasContent())
+                index = 0;
+            else if (!panes[1]->wrapper.hasContent())
+                index = 1;
+        }
+
+        if (index < 0)
+        {
+            addPane (label);
+            index = panes.size() - 1;
+        }
+        else
         {
-            wrapper = std::make_unique<ComponentWrapper>();
-            addAndMakeVisible (wrapper.get());
-            wrapper->toBehind (&divider);
+            panes[index]->button.setButtonText (label);
         }
-        wrapper->setContent (component);
+
+        panes[index]->wrapper.setContent (component);
         updateChildBounds();
         setViewMode (currentMode);
+        return index;
     }
 
-    void SplitView::mouseMove (const juce::MouseEvent& e)
+    void SplitView::removeDisplayedComponent (int index)
     {
-        if (currentMode == ViewMode::Split && leftWrapper && rightWrapper)
+        if (!juce::isPositiveAndBelow (index, panes.size()))
+            return;
+
+        if (index < 2)
+        {
+            panes[index]->wrapper.setContent (nullptr);
+            panes[index]->ownedContent.reset();
+        }
+        else
         {
-            auto mouseScreenX = e.getScreenPosition().x;
-            auto dividerScreenX = divider.getScreenX() + DividerComponent::width / 2.0f;
+            // Dividers are numbered by position, so the last one goes
+            dividers.removeObject (dividers.getLast());
+            panes.remove (index);
+            resetDividerPositions();
 
-            if (mouseScreenX < dividerScreenX)
-            {
-                rightWrapper->toBack();
-            }
-            else
+            const auto adjustIndex = [index] (int& i, int fallback) {
+                if (i == index)
+                    i = fallback;
+                else if (i > index)
+                    --i;
+            };
+
+            adjustIndex (singleComponentIndex, 0);
+            adjustIndex (activeComponentIndex, 0);
+            adjustIndex (comparedA, 0);
+            adjustIndex (comparedB, 1);
+        }
+
+        metricsTiles.reset();
+        regionTiles.reset();
+        updateChildBounds();
+        setViewMode (currentMode);
+    }
+
+    void SplitView::setComparedComponents (int indexA, int indexB)
+    {
+        jassert (juce::isPositiveAndBelow (indexA, panes.size()) && juce::isPositiveAndBelow (indexB, panes.size()));
+        if (indexA == comparedA && indexB == comparedB)
+            return;
+
+        comparedA = indexA;
+        comparedB = indexB;
+        metricsTiles.reset();
+        regionTiles.reset();
+
+        // The history only holds the pair it was captured from
+        history.clear();
+        historyPosition = 0;
+        updateHistorySlider();
+
+        // An alignment only holds for the pair it was estimated from
+        autoAligner.cancel();
+        alignment.reset();
+        updateAlignment();
+
+        if (metricsEnabled)
+        {
+            metricsEngine.cancel();
+            metricsEngine.markDirty();
+        }
+
+        if (differenceRegionsEnabled)
+        {
+            regionEngine.cancel();
+            updateDifferenceRegions ({});
+            regionEngine.markDirty();
+        }
+
+        setViewMode (currentMode);
+    }
+
+    void SplitView::mouseMove (const juce::MouseEvent& e)
+    {
+        const auto position = e.getEventRelativeTo (this).position;
+        updateMagnifier (position);
+
+        if (currentMode != ViewMode::Split)
+            return;
+
+        for (auto i = 0; i < panes.size(); ++i)
+        {
+            if (panes[i]->wrapper.hasContent() && getPaneRegion (i).contains (position))
             {
-                leftWrapper->toBack();
+                setActiveComponent (i);
+                break;
             }
         }
     }
 
+    void SplitView::mouseDrag (const juce::MouseEvent& e)
+    {
+        updateMagnifier (e.getEventRelativeTo (this).position);
+    }
+
+    void SplitView::mouseExit (const juce::MouseEvent& e)
+    {
+        // Moving between children also exits the previous child
+        updateMagnifier (e.getEventRelativeTo (this).position);
+    }
+
+    void SplitView::mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel)
+    {
+        // Events reach this both as a mouse listener of the children and, when
+        // a child doesn't use them, through the parent chain; only react once.
+        // The slider handles the wheel itself.
+        if (currentMode != ViewMode::Blend || e.eventComponent != e.originalComponent || e.originalComponent == &blendSlider)
+            return;
+
+        const auto delta = std::abs (wheel.deltaX) > std::abs (wheel.deltaY) ? -wheel.deltaX : wheel.deltaY;
+        setBlendAmount (blendAmount + (wheel.isReversed ? -delta : delta) * 0.25f);
+    }
+
+    void SplitView::showSingleComponent (int componentIndex)
+    {
+        if (!juce::isPositiveAndBelow (componentIndex, panes.size()))
+            return;
+
+        singleComponentIndex = componentIndex;
+        setViewMode (componentIndex == 0 ? ViewMode::A
+                     : componentIndex == 1 ? ViewMode::B
+                                           : ViewMode::Single);
+    }
+
     void SplitView::setViewMode (ViewMode newMode)
     {
         currentMode = newMode;
@@ -250,62 +1767,153 @@ namespace BogrenDigital
             }
         };
 
-        const auto buttons = std::array { &showBothButton, &showLeftButton, &showRightButton };
-        for (auto i = 0; i < buttons.size(); ++i)
-        {
-            buttons[i]->setToggleState (static_cast<int>(newMode) == i, juce::dontSendNotification);
-        }
+        const auto singleIndex = getSingleComponentIndex();
+        for (auto i = 0; i < panes.size(); ++i)
+            panes[i]->button.setToggleState (i == singleIndex, juce::dontSendNotification);
 
-        // Reset all effects first
-        if (leftWrapper)
-            leftWrapper->setComponentEffect (nullptr);
-        if (rightWrapper)
-            rightWrapper->setComponentEffect (nullptr);
+        showBothButton.setToggleState (newMode == ViewMode::Split, juce::dontSendNotification);
+        showDifferenceButton.setToggleState (newMode == ViewMode::Difference, juce::dontSendNotification);
+        showBlendButton.setToggleState (newMode == ViewMode::Blend, juce::dontSendNotification);
+
+        // Reset all clipping first
+        for (auto* pane : panes)
+            pane->wrapper.clearClipping();
 
         switch (currentMode)
         {
             case ViewMode::A:
-                toggleComp (leftWrapper.get(), true);
-                toggleComp (rightWrapper.get(), false);
-                toggleComp (&divider, false);
-                break;
-
             case ViewMode::B:
-                toggleComp (leftWrapper.get(), false);
-                toggleComp (rightWrapper.get(), true);
-                toggleComp (&divider, false);
-                break;
+            case ViewMode::Single:
+                for (auto i = 0; i < panes.size(); ++i)
+                    toggleComp (&panes[i]->wrapper, i == singleIndex && panes[i]->wrapper.hasContent());
 
-            case ViewMode::Split:
-                auto divX = (int) getDividerX();
-                toggleComp (leftWrapper.get(), true);
-                toggleComp (rightWrapper.get(), true);
-                toggleComp (&divider, true);
+                // Only needed to see the invalidations
+                if (repaintHeatmapEnabled && panes[singleIndex]->wrapper.hasContent())
+                    panes[singleIndex]->wrapper.setUnclipped();
+
+                for (auto* divider : dividers)
+                    toggleComp (divider, false);
+
+                toggleComp (&composite, false);
+                break;
 
-                if (leftWrapper)
+            case ViewMode::Difference:
+            case ViewMode::Blend:
+                for (auto i = 0; i < panes.size(); ++i)
                 {
-                    if (!leftEffect)
-                        leftEffect.reset (new ClippingRegionEffect (getLocalBounds().withRight (divX)));
-                    leftWrapper->setComponentEffect (leftEffect.get());
+                    auto& wrapper = panes[i]->wrapper;
+                    const auto isCompared = (i == comparedA || i == comparedB) && wrapper.hasContent();
+                    toggleComp (&wrapper, isCompared);
+
+                    if (isCompared)
+                        wrapper.setCapturing (maxCompositeRate > 0.0);
                 }
 
-                if (rightWrapper)
+                for (auto* divider : dividers)
+                    toggleComp (divider, false);
+
+                toggleComp (&composite, true);
+                composite.invalidateComposite();
+                break;
+
+            case ViewMode::Split:
+                for (auto i = 0; i < panes.size(); ++i)
                 {
-                    if (!rightEffect)
-                        rightEffect.reset (new ClippingRegionEffect (getLocalBounds().withLeft (divX)));
-                    rightWrapper->setComponentEffect (rightEffect.get());
+                    auto& wrapper = panes[i]->wrapper;
+                    const auto region = getPaneRegion (i);
+                    toggleComp (&wrapper, wrapper.hasContent() && !region.isEmpty());
+
+                    if (wrapper.hasContent())
+                        wrapper.setClipping (getSplitRenderingMode(), region);
                 }
+
+                for (auto* divider : dividers)
+                    toggleComp (divider, true);
+
+                toggleComp (&composite, false);
                 break;
         }
 
-        if ((leftWrapper != nullptr && leftWrapper->getWidth() != getWidth())
-            || (rightWrapper != nullptr && rightWrapper->getWidth() != getWidth()))
+        // An earlier frame is shown in place of the live components
+        if (historyPosition > 0)
         {
-            resized();
+            for (auto* pane : panes)
+                toggleComp (&pane->wrapper, false);
+
+            toggleComp (&composite, false);
+            magnifier.setVisible (false);
+        }
+
+        historyView.setVisible (historyPosition > 0);
+        historyView.invalidateComposite();
+
+        blendSlider.setVisible (currentMode == ViewMode::Blend);
+        updateSuspension();
+
+        if (singleIndex >= 0)
+            setActiveComponent (singleIndex);
+
+        if (getSingleComponentIndex() >= 0)
+            magnifier.setVisible (false);
+
+        for (auto* pane : panes)
+        {
+            if (pane->wrapper.isVisible() && pane->wrapper.getWidth() != getWidth())
+            {
+                resized();
+                break;
+            }
         }
+
         repaint();
     }
 
+    void SplitView::setDifferenceAmplification (int gain)
+    {
+        differenceOptions.gain = juce::jlimit (1, PixelKernels::maxDifferenceGain, gain);
+        if (currentMode == ViewMode::Difference)
+        {
+            composite.invalidateComposite();
+            historyView.invalidateComposite();
+        }
+    }
+
+    void SplitView::setDifferenceHeatmapEnabled (bool shouldUseHeatmap)
+    {
+        differenceOptions.heatmap = shouldUseHeatmap;
+        if (currentMode == ViewMode::Difference)
+        {
+            composite.invalidateComposite();
+            historyView.invalidateComposite();
+        }
+    }
+
+    void SplitView::setBlendAmount (float amountOfA)
+    {
+        amountOfA = juce::jlimit (0.0f, 1.0f, amountOfA);
+        if (amountOfA == blendAmount)
+            return;
+
+        blendAmount = amountOfA;
+        blendSlider.setValue (blendAmount, juce::dontSendNotification);
+
+        // The snapshots are unchanged, so this only re-blends the cached images
+        if (currentMode == ViewMode::Blend)
+        {
+            composite.invalidateComposite();
+            historyView.invalidateComposite();
+        }
+    }
+
+    void SplitView::setRenderingMode (RenderingMode newMode)
+    {
+        if (renderingMode == newMode)
+            return;
+
+        renderingMode = newMode;
+        setViewMode (currentMode);
+    }
+
     void SplitView::updateChildBounds()
     {
         const auto updateCompBounds = [this] (juce::Component* comp) {
@@ -315,27 +1923,64 @@ namespace BogrenDigital
             }
         };
 
-        updateCompBounds (leftWrapper.get());
-        updateCompBounds (rightWrapper.get());
+        for (auto* pane : panes)
+        {
+            updateCompBounds (&pane->wrapper);
+            pane->repaintHeatmap.setSize (getWidth(), getHeight());
+        }
+        composite.setBounds (getLocalBounds());
+        historyView.setBounds (getLocalBounds());
+        historySlider.setBounds (getHistorySliderBounds());
+
+        // The first component's button comes before Split, the others after it
+        std::vector<juce::Button*> buttons { &panes[0]->button, &showBothButton };
+        for (auto i = 1; i < panes.size(); ++i)
+            buttons.push_back (&panes[i]->button);
+        buttons.push_back (&showDifferenceButton);
+        buttons.push_back (&showBlendButton);
 
+        const int numButtons = (int) buttons.size();
         const int buttonHeight = 24;
-        const int buttonWidth = 60;
         const int spacing = 5;
-        const int totalWidth = buttonWidth * 3 + spacing * 2;
+        const int buttonWidth = juce::jlimit (0, 60, (getWidth() - 10 - spacing * (numButtons - 1)) / numButtons);
+        const int totalWidth = buttonWidth * numButtons + spacing * (numButtons - 1);
         const int startX = (getWidth() - totalWidth) / 2;
         const int buttonY = 5;
 
-        showLeftButton.setBounds (startX, buttonY, buttonWidth, buttonHeight);
-        showBothButton.setBounds (startX + buttonWidth + spacing, buttonY, buttonWidth, buttonHeight);
-        showRightButton.setBounds (startX + (buttonWidth + spacing) * 2, buttonY, buttonWidth, buttonHeight);
+        for (auto i = 0; i < numButtons; ++i)
+            buttons[(size_t) i]->setBounds (startX + (buttonWidth + spacing) * i, buttonY, buttonWidth, buttonHeight);
 
+        blendSlider.setBounds (startX, buttonY + buttonHeight + spacing, totalWidth, buttonHeight);
+
+        auto numProfiledPanes = 0;
+        for (auto* pane : panes)
+            numProfiledPanes += pane->wrapper.hasContent() ? 1 : 0;
+
+        profilerOverlay.setBounds (5, buttonY + (buttonHeight + spacing) * 2, 300, ProfilerOverlay::rowHeight * (numProfiledPanes + 1) + 8);
+
+        dividerGeometry.setBounds (getLocalBounds());
         updateDividerBounds();
     }
 
     void SplitView::updateDividerBounds()
     {
-        auto divX = getDividerX();
-        divider.setBounds (divX - DividerComponent::width / 2.0f, 0, DividerComponent::width, getHeight());
+        for (auto i = 0; i < dividers.size(); ++i)
+        {
+            const auto line = dividerGeometry.getDividerLine (getDividerOffset (i));
+            const auto centre = line.getPointAlongLineProportionally (0.5f);
+
+            // A vertical strip along the divider, rotated into place unless it's axis-aligned
+            auto bounds = juce::Rectangle<float> (DividerComponent::width, line.getLength()).withCentre (centre);
+            auto transform = juce::AffineTransform();
+
+            if (dividerGeometry.isAxisAligned() && dividerGeometry.getNormal().x == 0.0f)
+                bounds = juce::Rectangle<float> (line.getLength(), DividerComponent::width).withCentre (centre);
+            else if (!dividerGeometry.isAxisAligned())
+                transform = juce::AffineTransform::rotation (juce::degreesToRadians (getDividerAngle()), centre.x, centre.y);
+
+            dividers[i]->setTransform (transform);
+            dividers[i]->setBounds (bounds.toNearestInt());
+        }
     }
 
-} // namespace BogrenDigital
\ No newline at end of file
+} // namespace BogrenDigital
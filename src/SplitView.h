@@ -8,10 +8,10 @@
 namespace BogrenDigital
 {
     /**
-     * @brief This class provides a split view layout with two components that can
-     * be toggled between different views. It allows the user to switch between
-     * showing both components side-by-side, only the left component, or only the
-     * right component.
+     * @brief This class provides a split view layout with two or more components
+     * that can be toggled between different views. It allows the user to switch
+     * between showing all components side-by-side, separated by draggable
+     * dividers, or only one of them.
      */
     class SplitView : public juce::Component
     {
@@ -28,16 +28,63 @@ namespace BogrenDigital
          */
         void setDisplayedComponent (juce::Component* component, bool isLeft);
 
+        /**
+         * @brief Shows an image file, such as a mockup, as the left or right
+         * side, through a ReferenceImageComponent owned by the view.
+         * @details The file is decoded lazily on a background thread, drawn
+         * from a mip pyramid and reloaded when it changes on disk.
+         * @return The component showing the image, e.g. to change its placement.
+         */
+        ReferenceImageComponent& setDisplayedImage (const juce::File& imageFile, bool isLeft);
+
+        /**
+         * @brief Shows the frames published by a SharedFramePublisher in
+         * another process, such as a previous release of the same plugin, as
+         * the left or right side, through a SharedFrameComponent owned by the view.
+         * @details Mouse input on the side is sent back to the publisher.
+         * @return The component showing the frames, e.g. to check whether it is connected.
+         */
+        SharedFrameComponent& setDisplayedSharedFrames (const juce::String& channelName, bool isLeft);
+
+        /**
+         * @brief Adds a component to compare, shown to the right of the ones
+         * added before. The view does not take ownership of the component.
+         * @details The first two calls fill the A and B slots, so they are
+         * equivalent to setDisplayedComponent(). Each further call adds a pane,
+         * a divider and a button, and spreads the dividers evenly.
+         * @param component The component to add.
+         * @param label The text of the button that shows only this component.
+         * @return The index of the component.
+         */
+        int addDisplayedComponent (juce::Component* component, const juce::String& label);
+
+        /**
+         * @brief Removes the component at the given index. The A and B slots
+         * are kept, but left empty.
+         */
+        void removeDisplayedComponent (int index);
+
+        /**
+         * @brief Returns the number of panes, which is at least two.
+         */
+        int getNumDisplayedComponents() const { return panes.size(); }
+
         /**
          * @brief Enum type that defines the view modes for the SplitView.
-         * @details The SplitView can be in one of three modes:
-         * - Split: Both components are visible.
-         * - A: Only the left component is visible.
-         * - B: Only the right component is visible.
+         * @details The SplitView can be in one of six modes:
+         * - Split: All components are visible, side by side.
+         * - A: Only the first (left) component is visible.
+         * - B: Only the second (right) component is visible.
+         * - Difference: The per-pixel difference |A-B| of the compared components is shown.
+         * - Blend: A is shown over B at an adjustable opacity (onion skin).
+         * - Single: Only the component chosen with showSingleComponent() is visible.
          */
         enum class ViewMode { Split,
             A,
-            B };
+            B,
+            Difference,
+            Blend,
+            Single };
 
         /**
          * @brief Sets the text for the toggle buttons based on the view mode.
@@ -46,6 +93,12 @@ namespace BogrenDigital
          */
         void setButtonText (ViewMode mode, const juce::String& text);
 
+        /**
+         * @brief Sets the text of the button that shows only the component at
+         * the given index.
+         */
+        void setButtonText (int componentIndex, const juce::String& text);
+
         /**
          * @brief Enum class that defines the available visual styles.
          */
@@ -69,26 +122,390 @@ namespace BogrenDigital
 
         /**
          * @brief Sets the current view mode of the SplitView.
-         * @param newMode The new view mode to set (Split, A, or B).
+         * @param newMode The new view mode to set: Split shows the components
+         * side by side between the dividers, A and B show only the first or
+         * second of them, Single only the one chosen with
+         * showSingleComponent(), and Difference and Blend composite the two
+         * compared components.
          */
         void setViewMode (ViewMode newMode);
 
+        /**
+         * @brief Shows only the component at the given index.
+         */
+        void showSingleComponent (int componentIndex);
+
+        /**
+         * @brief Returns the index of the component the user is looking at:
+         * the one shown alone, or in Split mode the one under the mouse.
+         * Difference and Blend mode keep the one from before.
+         */
+        int getActiveComponentIndex() const { return activeComponentIndex; }
+
+        /**
+         * @brief Called on the message thread when getActiveComponentIndex()
+         * changes, e.g. to switch which of two processors is heard.
+         */
+        std::function<void (int componentIndex)> onActiveComponentChanged;
+
+        /**
+         * @brief Selects the components that Difference mode, Blend mode and
+         * the metrics compare. Default is the first and the second.
+         */
+        void setComparedComponents (int indexA, int indexB);
+
+        /**
+         * @brief Moves a divider in Split mode.
+         * @param dividerIndex The divider between component dividerIndex and
+         * dividerIndex + 1.
+         * @param proportion The position as a proportion of the extent of the
+         * view across the dividers, i.e. of the width for vertical dividers. It
+         * is limited to the range between the neighbouring dividers; a pane
+         * that shrinks to nothing is not painted at all.
+         */
+        void setDividerPosition (int dividerIndex, float proportion);
+        float getDividerPosition (int dividerIndex) const;
+
+        /**
+         * @brief Enum class that defines the axis-aligned divider orientations.
+         * @details
+         * - Vertical: The panes are side by side, from left to right.
+         * - Horizontal: The panes are stacked, from top to bottom.
+         */
+        enum class DividerOrientation { Vertical,
+            Horizontal };
+
+        /**
+         * @brief Sets the orientation of the dividers. Default is Vertical.
+         * @details Equivalent to setDividerAngle (0) or setDividerAngle (90).
+         */
+        void setDividerOrientation (DividerOrientation orientation);
+
+        /**
+         * @brief Rotates the dividers, for comparing along a diagonal.
+         * @param degrees Clockwise from vertical, limited to -90 to 90. Panes
+         * next to an angled divider are clipped to a path instead of a
+         * rectangle, which costs a little more per paint, but the path is
+         * shared and only rebuilt when the view is resized.
+         */
+        void setDividerAngle (float degrees);
+        float getDividerAngle() const { return dividerGeometry.getAngle(); }
+
+        /**
+         * @brief Enum class that defines how each side is clipped in Split mode.
+         * @details
+         * - DirectClip: Each side is painted straight into the window under a
+         *   reduced clip, so only the visible pixels are rasterised.
+         * - Snapshot: Each side is kept in a cached image that is only
+         *   re-rendered where the side actually repaints. Moving the divider
+         *   just composites the cached images, which keeps dragging smooth
+         *   across expensive components at the cost of two full-size images.
+         * - ComponentEffect: Each side is rendered into a full-size offscreen
+         *   image, which is then clipped. Slower, but kept as a fallback for
+         *   components that misbehave when painted under an external clip.
+         *   The offscreen images come from a pool, see setOffscreenMemoryBudget().
+         */
+        enum class RenderingMode { DirectClip,
+            Snapshot,
+            ComponentEffect };
+
+        /**
+         * @brief Sets how the two sides are clipped in Split mode.
+         * @param newMode The rendering mode to use. Default is DirectClip.
+         */
+        void setRenderingMode (RenderingMode newMode);
+
+        /**
+         * @brief Returns the current rendering mode.
+         */
+        RenderingMode getRenderingMode() const { return renderingMode; }
+
+        /**
+         * @brief Sets how much memory the view keeps in offscreen images for
+         * RenderingMode::ComponentEffect between frames.
+         * @details The images are reused across frames, panes and mode
+         * changes, and freed when the view is hidden. Frames that need more
+         * than the budget still paint, with the excess allocated per frame.
+         * Default is OffscreenBufferPool::defaultBudget.
+         */
+        void setOffscreenMemoryBudget (size_t bytes) { bufferPool.setBudget (bytes); }
+        size_t getOffscreenMemoryBudget() const { return bufferPool.getBudget(); }
+
+        /**
+         * @brief Sets the amplification applied in Difference mode.
+         * @param gain Factor the channel differences are multiplied by, from 1
+         * to PixelKernels::maxDifferenceGain. Default is 1.
+         */
+        void setDifferenceAmplification (int gain);
+
+        /**
+         * @brief Enables the false-colour heatmap in Difference mode.
+         * @param shouldUseHeatmap If true, the largest channel difference of each
+         * pixel is shown on a black-to-white heat scale instead of |A-B| per channel.
+         */
+        void setDifferenceHeatmapEnabled (bool shouldUseHeatmap);
+
+        /**
+         * @brief Sets the opacity of A over B in Blend mode.
+         * @param amountOfA From 0 (only B) to 1 (only A). Default is 0.5. The
+         * user can also change it with the slider or the mouse wheel.
+         */
+        void setBlendAmount (float amountOfA);
+        float getBlendAmount() const { return blendAmount; }
+
+        /**
+         * @brief Enables the live readout of DiffMetrics between A and B.
+         * @details The metrics are computed off the message thread whenever
+         * either side repaints, and shown at the bottom of the view. While
+         * enabled, Split mode renders through snapshots regardless of the
+         * rendering mode, as the metrics are computed from them.
+         */
+        void setMetricsEnabled (bool shouldShowMetrics);
+        bool isMetricsEnabled() const { return metricsEnabled; }
+
+        /**
+         * @brief Called on the message thread whenever new metrics are available.
+         */
+        std::function<void (const DiffMetrics&)> onMetricsUpdated;
+
+        /**
+         * @brief Outlines the regions where the compared components differ,
+         * and steps through them with the keyboard.
+         * @details The regions are labelled off the message thread by a
+         * DifferenceRegionEngine whenever either side repaints, and outlined
+         * while both compared components are shown. While enabled, Split mode
+         * renders through snapshots regardless of the rendering mode, and the
+         * view wants keyboard focus, so that the keys set with
+         * setDifferenceRegionKeys() reach it unless a component inside uses
+         * them first.
+         */
+        void setDifferenceRegionsEnabled (bool shouldShowRegions);
+        bool isDifferenceRegionsEnabled() const { return differenceRegionsEnabled; }
+
+        /** Returns the latest regions in the view's coordinates, sorted top to bottom, then left to right. */
+        const std::vector<juce::Rectangle<float>>& getDifferenceRegions() const { return differenceRegions; }
+
+        /**
+         * @brief Selects the region at index, moves the divider between the
+         * compared components through its centre, and shows it in the loupe,
+         * as far zoomed in as it still fits.
+         * @details The divider only moves if the compared components are
+         * next to each other. The loupe is only shown if the magnifier is
+         * enabled, and getMagnifierZoom() is left as it is; the loupe goes
+         * back to following the mouse at that zoom once the mouse moves. The
+         * selection follows its region when the regions are updated, and is
+         * cleared once the region is gone.
+         * @param index An index into getDifferenceRegions(), or -1 to clear
+         * the selection.
+         */
+        void showDifferenceRegion (int index);
+        int getSelectedDifferenceRegion() const { return selectedDifferenceRegion; }
+
+        /** Shows the region after the selected one, wrapping around at the last. */
+        void showNextDifferenceRegion();
+
+        /** Shows the region before the selected one, wrapping around at the first. */
+        void showPreviousDifferenceRegion();
+
+        /** Sets the keys that show the next and the previous region. Default is F8 and Shift+F8. */
+        void setDifferenceRegionKeys (const juce::KeyPress& nextKey, const juce::KeyPress& previousKey);
+
+        /** Called on the message thread whenever the regions are updated. */
+        std::function<void (const std::vector<juce::Rectangle<float>>&)> onDifferenceRegionsUpdated;
+
+        /**
+         * @brief Shows a loupe beside the mouse with the pixels of the compared
+         * components under it side by side, magnified with a pixel grid, and
+         * the ARGB value of the pixel under the mouse.
+         * @details The loupe samples the snapshots at physical pixel scale
+         * instead of re-rendering the components. While enabled, Split mode
+         * renders through snapshots regardless of the rendering mode. The loupe
+         * is hidden while only one component is shown.
+         */
+        void setMagnifierEnabled (bool shouldShowMagnifier);
+        bool isMagnifierEnabled() const { return magnifierEnabled; }
+
+        static constexpr int minMagnifierZoom = 4;
+        static constexpr int maxMagnifierZoom = 32;
+
+        /**
+         * @brief Sets how many physical pixels wide each magnified pixel is,
+         * from minMagnifierZoom to maxMagnifierZoom. Default is 8.
+         */
+        void setMagnifierZoom (int zoom);
+        int getMagnifierZoom() const { return magnifierZoom; }
+
+        /**
+         * @brief Times every paint of each component, and shows rolling
+         * p50/p95/max paint times, paint calls and repainted area per frame
+         * in an overlay.
+         * @details Each paint is measured from the start of the component's
+         * paint to the end of its children's, in the rendering mode in use. In
+         * Snapshot mode only re-rendering the snapshot counts. The overlay's
+         * own refreshes show up as small paints under it.
+         */
+        void setProfilerEnabled (bool shouldProfile);
+        bool isProfilerEnabled() const { return profilerEnabled; }
+
+        /**
+         * @brief Shows where each component invalidates itself, as a heatmap
+         * that cools down over a second or so, and the pixels each one
+         * invalidates per second.
+         * @details Over-invalidating components show up as large warm areas
+         * even when they paint quickly. Recording only costs a few additions
+         * per repaint request, so it can be left on. The overlay is refreshed
+         * on display refreshes at 10 Hz, which only repaints the warm areas.
+         */
+        void setRepaintHeatmapEnabled (bool shouldShowHeatmap);
+        bool isRepaintHeatmapEnabled() const { return repaintHeatmapEnabled; }
+
+        /**
+         * @brief Returns the pixels the component at the given index
+         * invalidated per second over the last RepaintHeatmap::windowSeconds,
+         * while the heatmap was enabled.
+         */
+        double getInvalidatedPixelsPerSecond (int componentIndex);
+
+        /**
+         * @brief The samples recorded while the profiler was enabled, with the
+         * source being the index of the component. Can be read and exported
+         * from any thread.
+         */
+        const PaintProfiler& getProfiler() const { return profiler; }
+
+        /**
+         * @brief Returns the button labels of the components, for naming the
+         * tracks of PaintProfiler::writeChromeTrace().
+         */
+        juce::StringArray getComponentLabels() const;
+
+        /**
+         * @brief Records the view as composited on screen to a numbered image
+         * sequence, at a fixed rate and at the physical scale of the display.
+         * @details Frames are encoded on a background thread. If it falls
+         * behind, frames are dropped instead of stalling the UI. While
+         * recording, Split mode renders through snapshots, so capturing a
+         * frame doesn't re-render the components.
+         * @return false if the directory couldn't be created.
+         */
+        bool startRecording (const juce::File& directory,
+            FrameRecorder::Format format = FrameRecorder::Format::PNG,
+            int framesPerSecond = 30);
+
+        /** Stops recording, and returns once every captured frame is written. */
+        void stopRecording();
+        bool isRecording() const { return recorder.isRecording(); }
+
+        /** Returns the recorder, e.g. for the number of dropped frames. */
+        const FrameRecorder& getRecorder() const { return recorder; }
+
+        /**
+         * @brief Keeps a rolling history of the frames of the compared
+         * components, to step back to glitches that only last a frame or two.
+         * @details A frame is captured on each display refresh after either
+         * compared component changed its pixels, and stored in a FrameHistory
+         * as the tiles that changed. Frames are captured from the snapshots,
+         * so while enabled, Split mode renders through snapshots regardless of
+         * the rendering mode; A and B mode capture nothing, as they show one
+         * component only. A scrub slider is shown at the bottom of the view.
+         * Default is off.
+         */
+        void setHistoryEnabled (bool shouldKeepHistory);
+        bool isHistoryEnabled() const { return historyEnabled; }
+
+        /** Sets how much memory the stored frames may take. Default is FrameHistory::defaultBudget. */
+        void setHistoryMemoryBudget (size_t bytes) { history.setMemoryBudget (bytes); }
+        size_t getHistoryMemoryBudget() const { return history.getMemoryBudget(); }
+
+        int getNumHistoryFrames() const { return history.getNumFrames(); }
+
+        /**
+         * @brief Shows an earlier frame from the history in the current view
+         * mode, or the live components for 0.
+         * @details While an earlier frame is shown, the live components are
+         * hidden and no frames are captured. Changing the compared components
+         * clears the history.
+         * @param framesBack How many frames before the newest, limited to
+         * getNumHistoryFrames() - 1.
+         */
+        void setHistoryPosition (int framesBack);
+        int getHistoryPosition() const { return historyPosition; }
+
+        /**
+         * @brief Limits how often Difference and Blend mode recomposite while
+         * the compared components animate, independently of how often they
+         * repaint themselves.
+         * @param framesPerSecond The highest rate, or 0 for no limit, which is
+         * the default. Repaints of the components in between are collected and
+         * applied together on the next display refresh that is due.
+         */
+        void setMaxCompositeRate (double framesPerSecond);
+        double getMaxCompositeRate() const { return maxCompositeRate; }
+
+        /**
+         * @brief Pauses the components that are hidden, such as the other side
+         * in A or B mode, or a pane squeezed to nothing in Split mode, so they
+         * don't skew a performance comparison.
+         * @details Components that are juce::Timers have their timers stopped,
+         * and restarted with the same interval when shown again. Components
+         * that implement SplitViewSuspendable are notified instead, and look
+         * after everything below them. Every component is resumed when it is
+         * removed, replaced or the view is deleted. Default is off.
+         */
+        void setSuspendHiddenComponents (bool shouldSuspend);
+        bool isSuspendingHiddenComponents() const { return suspendHiddenComponents; }
+
+        /**
+         * @brief Repeats the mouse and keyboard input that one component gets
+         * on the others, at the same position, so their states stay in sync.
+         * @details See InputMirror for what can and can't be mirrored. Default
+         * is off.
+         */
+        void setInputMirroringEnabled (bool shouldMirror) { inputMirror.setEnabled (shouldMirror); }
+        bool isInputMirroringEnabled() const { return inputMirror.isEnabled(); }
+
+        /**
+         * @brief Estimates how B is shifted and scaled against A, such as an
+         * implementation against its mockup, and draws B moved into line.
+         * @details Works on the snapshots if the rendering mode keeps them, or
+         * renders both components once otherwise, and estimates on a
+         * background thread with Alignment::estimate(). Estimates below
+         * Alignment::minimumConfidence are reported but not applied.
+         */
+        void autoAlign();
+
+        /** Called on the message thread with the result of autoAlign(), in the view's coordinates. */
+        std::function<void (const std::optional<Alignment>&)> onAutoAligned;
+
+        /**
+         * @brief Sets how B is moved when drawn in Split, Difference and Blend
+         * mode, in the view's coordinates, or std::nullopt to draw it where it
+         * is, which is the default.
+         * @details Only the drawing moves: the mouse, the metrics and the
+         * magnifier still see B where it is. Cleared when the compared
+         * components change.
+         */
+        void setAlignment (const std::optional<Alignment>& newAlignment);
+        const std::optional<Alignment>& getAlignment() const { return alignment; }
+
     private:
         class DividerComponent : public juce::Component
         {
         public:
-            explicit DividerComponent (SplitView& parent);
+            DividerComponent (SplitView& parent, int dividerIndex);
             void paint (juce::Graphics& g) override;
             void mouseDown (const juce::MouseEvent& e) override;
             void mouseDrag (const juce::MouseEvent& e) override;
 
             void setStyle (Style style);
             Style getStyle() const { return currentStyle; }
+            void updateMouseCursor();
 
             static constexpr float width = 4.0f;
 
         private:
             SplitView& owner;
+            const int index;
             bool isDragging = false;
             Style currentStyle = Style::Light;
 
@@ -139,36 +556,302 @@ namespace BogrenDigital
         class ComponentWrapper : public juce::Component
         {
         public:
-            explicit ComponentWrapper();
+            explicit ComponentWrapper (OffscreenBufferPool& pool);
             ~ComponentWrapper() override = default;
 
             void setContent (juce::Component* component);
+            bool hasContent() const { return content != nullptr; }
+            juce::Component* getContent() const { return content; }
             void resized() override;
 
+            /** Only accepts the mouse inside the clip region in Split mode. */
+            bool hitTest (int x, int y) override;
+
+            /** Pauses or resumes the work of the content. Changing the content resumes it. */
+            void setSuspended (bool shouldBeSuspended);
+
+            /**
+             * @brief Restricts painting to the given region using the given
+             * rendering mode.
+             */
+            void setClipping (RenderingMode mode, const ClipRegion& clipRegion);
+            void updateClipRegion (const ClipRegion& clipRegion);
+            void clearClipping();
+
+            /** Moves where the content is drawn inside the clip region, in Split mode. */
+            void setContentTransform (const juce::AffineTransform& newTransform);
+
+            /**
+             * @brief Keeps a snapshot of the content up to date without drawing
+             * anything, for modes that composite both sides themselves.
+             * @param holdRepaints If true, repaints of the content don't reach
+             * the view; the owner polls takeHeldRepaint() instead.
+             */
+            void setCapturing (bool holdRepaints);
+
+            /** Paints the content as usual, but still reports its invalidations. */
+            void setUnclipped();
+            bool takeHeldRepaint();
+            juce::Image getSnapshot() const;
+
+            std::function<void (const juce::RectangleList<int>&)> onSnapshotUpdated;
+
+            void paint (juce::Graphics& g) override;
+            void paintOverChildren (juce::Graphics& g) override;
+
+            /** Called after the wrapper and its content have painted, if set. */
+            std::function<void (juce::int64 startTicks, juce::int64 endTicks, juce::Rectangle<int> area)> onPainted;
+
+            /** Called whenever the content invalidates an area, if set. */
+            std::function<void (juce::Rectangle<int>)> onInvalidated;
+
+            /** Tile hashes of the snapshot, kept up to date by the SplitView. */
+            TileHashMap& getTiles() { return tiles; }
+
         private:
             juce::Component* content = nullptr;
+            TileHashMap tiles;
+            juce::int64 paintStartTicks = 0;
+            juce::Rectangle<int> paintArea;
+            OffscreenBufferPool& bufferPool;
+            ClippedComponentImage* clippedImage = nullptr; // Owned by the component
+            std::optional<ClipRegion> hitRegion;
+            juce::AffineTransform contentTransform;
+            SubtreeSuspender suspender;
             JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ComponentWrapper)
         };
 
+        class CompositeComponent : public juce::Component
+        {
+        public:
+            explicit CompositeComponent (SplitView& parent);
+            void paint (juce::Graphics& g) override;
+            void visibilityChanged() override;
+
+            /** Recomposites every tile on the next paint. */
+            void invalidateComposite();
+
+        private:
+            SplitView& owner;
+            juce::Image compositeImage;
+            juce::Image alignedB; // B's snapshot moved by the alignment
+            TileHashMap::DirtyTracker compositeTiles;
+
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CompositeComponent)
+        };
+
+        class HistoryComponent : public juce::Component
+        {
+        public:
+            explicit HistoryComponent (SplitView& parent);
+            void paint (juce::Graphics& g) override;
+            void visibilityChanged() override;
+
+            /** Recomposites the given tiles of the decoded frames on the next paint. */
+            void frameChanged (const std::vector<int>& changedTiles);
+
+            /** Recomposites every tile on the next paint. */
+            void invalidateComposite();
+
+        private:
+            void updateComposite (const juce::Image& frameA, const juce::Image& frameB, float scale);
+
+            SplitView& owner;
+            juce::Image compositeImage;
+            juce::Image alignedB;
+            std::vector<int> dirtyTiles;
+            bool allTilesDirty = true;
+
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HistoryComponent)
+        };
+
+        class MagnifierComponent : public juce::Component
+        {
+        public:
+            explicit MagnifierComponent (SplitView& parent);
+            void paint (juce::Graphics& g) override;
+
+            /** Samples around position, in the coordinates of the SplitView, and moves beside it. */
+            void setSamplePosition (juce::Point<float> position);
+
+            /**
+             * @brief Shows area, in the coordinates of the SplitView, at the
+             * highest zoom that still fits it, and moves beside it.
+             * @details The zoom only holds until the next setSamplePosition(),
+             * and doesn't change the owner's magnifier zoom. An area too large
+             * to magnify is shrunk to fit instead.
+             */
+            void showArea (juce::Rectangle<float> area);
+
+        private:
+            void paintPanel (juce::Graphics& g, juce::Rectangle<int> area, float scale, bool isFirst);
+            void paintLabel (juce::Graphics& g, juce::Rectangle<int> area, const juce::Image& snapshot, juce::Point<int> centre, bool isFirst);
+            void moveBeside (juce::Rectangle<float> area);
+
+            static constexpr int panelSize = 128;
+            static constexpr int labelHeight = 16;
+            static constexpr int spacing = 4;
+
+            SplitView& owner;
+            juce::Point<float> samplePosition;
+            std::optional<juce::Rectangle<float>> shownArea; // Set while showing an area rather than following the mouse
+            std::array<juce::Image, 2> magnified;
+
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (MagnifierComponent)
+        };
+
+        class ProfilerOverlay : public juce::Component,
+                                private juce::Timer
+        {
+        public:
+            explicit ProfilerOverlay (SplitView& parent);
+            void paint (juce::Graphics& g) override;
+            void visibilityChanged() override;
+
+            static constexpr int rowHeight = 16;
+            static constexpr int numFrames = 120; // Frames the statistics roll over
+
+        private:
+            void timerCallback() override;
+
+            SplitView& owner;
+
+            JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ProfilerOverlay)
+        };
+
+        struct Pane
+        {
+            explicit Pane (OffscreenBufferPool& pool) : wrapper (pool) {}
+
+            ~Pane()
+            {
+                // Taking the content out repaints the wrapper, which mustn't reach the heatmap once it's gone
+                wrapper.onInvalidated = nullptr;
+                wrapper.setContent (nullptr);
+            }
+
+            ComponentWrapper wrapper;
+            juce::ToggleButton button;
+            std::unique_ptr<juce::Component> ownedContent; // Set if the pane owns its content
+            RepaintHeatmap repaintHeatmap;
+        };
+
         void resized() override;
+        void visibilityChanged() override;
         void paintOverChildren (juce::Graphics& g) override;
+        void paintMetricsOverlay (juce::Graphics& g);
+        void paintDifferenceRegions (juce::Graphics& g);
+        void updateDifferenceRegions (const std::vector<DifferenceRegion>& regions);
+        void repaintDifferenceRegions();
+        juce::Rectangle<float> getDifferenceRegionOutline (int index) const;
+        DifferenceRegionEngine::Frames getRegionFrames();
+        void drawAligned (const juce::Image& source, juce::Image& dest, float scale) const;
+        bool keyPressed (const juce::KeyPress& key) override;
+        void paintRepaintHeatmap (juce::Graphics& g);
+        juce::Rectangle<int> getRepaintHeatmapLabelBounds() const;
+        void updateRepaintHeatmap();
+        juce::Rectangle<int> getMetricsOverlayBounds() const;
+        juce::Rectangle<int> getHistorySliderBounds() const;
+        void captureHistoryFrame();
+        void updateHistorySlider();
+        RenderingMode getSplitRenderingMode() const;
+        void handleSnapshotUpdated (ComponentWrapper& wrapper, const juce::RectangleList<int>& updatedArea);
         void mouseMove (const juce::MouseEvent& e) override;
+        void mouseDrag (const juce::MouseEvent& e) override;
+        void mouseExit (const juce::MouseEvent& e) override;
+        void mouseWheelMove (const juce::MouseEvent& e, const juce::MouseWheelDetails& wheel) override;
+        void updateMagnifier (juce::Point<float> position);
+        void moveDividerOnNextFrame (int dividerIndex, float proportion);
+        void handleVBlank();
+        Pane& addPane (const juce::String& label);
+        void resetDividerPositions();
+        ComponentWrapper* getWrapper (int index) const;
+        ComponentWrapper* getComparedWrapper (bool first) const;
+        int getSingleComponentIndex() const;
+        void setActiveComponent (int index);
+        void updatePaintHook (Pane& pane);
         void updateChildBounds();
         void updateDividerBounds();
-        void setDividerPosition (float xPos);
-        float getDividerX() const;
+        void updateClipBounds();
+        void updateSuspension();
+        void updateAlignment();
+        float getDividerOffset (int dividerIndex) const;
+        ClipRegion getPaneRegion (int index) const;
+        juce::Rectangle<int> getDividerRepaintArea (float oldOffset, float newOffset) const;
 
         RadioButtonLookAndFeel radioButtonLookAndFeel;
-        juce::ToggleButton showLeftButton { "A" };
-        juce::ToggleButton showRightButton { "B" };
         juce::ToggleButton showBothButton { "Split" };
+        juce::ToggleButton showDifferenceButton { "Diff" };
+        juce::ToggleButton showBlendButton { "Blend" };
+        juce::Slider blendSlider { juce::Slider::LinearHorizontal, juce::Slider::NoTextBox };
         ViewMode currentMode = ViewMode::Split;
+        RenderingMode renderingMode = RenderingMode::DirectClip;
+        int singleComponentIndex = 0;
+        int activeComponentIndex = 0;
+        int comparedA = 0, comparedB = 1;
+
+        OffscreenBufferPool bufferPool; // Before the panes, whose wrappers use it
+        CompositeComponent composite;
+        HistoryComponent historyView;
+        MagnifierComponent magnifier;
+        ProfilerOverlay profilerOverlay;
+        juce::OwnedArray<Pane> panes;
+        juce::OwnedArray<DividerComponent> dividers;
+        std::vector<float> dividerPositions; // 0.0 to 1.0, one per divider
+        std::vector<std::optional<float>> pendingDividerPositions; // One per divider, applied on the next display refresh
+        DividerGeometry dividerGeometry;
+        Style dividerStyle = Style::Light;
+
+        juce::SharedResourcePointer<WorkerPool> workerPool;
+        PixelKernels::DifferenceOptions differenceOptions;
+        float blendAmount = 0.5f;
+
+        DiffMetricsEngine metricsEngine;
+        TileHashMap::DirtyTracker metricsTiles;
+        bool metricsEnabled = false;
+
+        DifferenceRegionEngine regionEngine;
+        TileHashMap::DirtyTracker regionTiles;
+        std::vector<juce::Rectangle<float>> differenceRegions; // In the view's coordinates
+        float regionScale = 1.0f; // Snapshot pixels per point of the labelling in flight
+        juce::Image regionAlignedB; // B's snapshot moved by the alignment, for the labelling
+        int selectedDifferenceRegion = -1;
+        bool differenceRegionsEnabled = false;
+        juce::KeyPress nextDifferenceRegionKey { juce::KeyPress::F8Key };
+        juce::KeyPress previousDifferenceRegionKey { juce::KeyPress::F8Key, juce::ModifierKeys::shiftModifier, 0 };
+
+        AutoAligner autoAligner;
+        std::optional<Alignment> alignment;
+        float autoAlignScale = 1.0f; // Snapshot pixels per point of the request in flight
+
+        bool magnifierEnabled = false;
+        int magnifierZoom = 8;
+
+        bool suspendHiddenComponents = false;
+        InputMirror inputMirror;
+
+        PaintProfiler profiler;
+        bool profilerEnabled = false;
+
+        bool repaintHeatmapEnabled = false;
+        double lastHeatmapUpdate = 0.0;
+
+        double maxCompositeRate = 0.0;
+        double lastCompositeTime = 0.0;
+        juce::VBlankAttachment vBlankAttachment;
+
+        FrameHistory history;
+        juce::Slider historySlider { juce::Slider::LinearHorizontal, juce::Slider::TextBoxRight };
+        bool historyEnabled = false;
+        bool historyDirty = false; // A compared snapshot changed since the last capture
+        int historyPosition = 0;
 
-        std::unique_ptr<ComponentWrapper> leftWrapper, rightWrapper;
-        std::unique_ptr<ClippingRegionEffect> leftEffect, rightEffect;
-        DividerComponent divider;
+        juce::Image lastRecordedFrame;
+        bool repaintedSinceRecordedFrame = true;
+        FrameRecorder recorder; // Last, so it stops capturing before anything else goes
 
-        float dividerPosition = 0.5f; // 0.0 to 1.0
+        static constexpr float dividerHandleRadius = 16.0f;
+        static constexpr float differenceRegionMargin = 3.0f; // Between a region and its outline
 
         JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SplitView)
     };
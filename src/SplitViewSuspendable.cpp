@@ -0,0 +1,62 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    void SubtreeSuspender::suspend (juce::Component& root)
+    {
+        if (suspended)
+            return;
+
+        suspended = true;
+        suspendComponent (root);
+    }
+
+    void SubtreeSuspender::suspendComponent (juce::Component& component)
+    {
+        if (auto* suspendable = dynamic_cast<SplitViewSuspendable*> (&component))
+        {
+            suspendable->splitViewSuspended();
+            suspendedComponents.push_back ({ &component, suspendable, 0 });
+            return;
+        }
+
+        // Only finds components that inherit juce::Timer publicly, which is the common case
+        if (auto* timer = dynamic_cast<juce::Timer*> (&component); timer != nullptr && timer->isTimerRunning())
+        {
+            suspendedComponents.push_back ({ &component, nullptr, timer->getTimerInterval() });
+            timer->stopTimer();
+        }
+
+        for (auto* child : component.getChildren())
+            suspendComponent (*child);
+    }
+
+    void SubtreeSuspender::resume()
+    {
+        if (!suspended)
+            return;
+
+        suspended = false;
+
+        // Children resume before their parents, as they were suspended after them
+        for (auto it = suspendedComponents.rbegin(); it != suspendedComponents.rend(); ++it)
+        {
+            auto* component = it->component.getComponent();
+            if (component == nullptr)
+                continue;
+
+            if (it->suspendable != nullptr)
+                it->suspendable->splitViewResumed();
+            else if (auto* timer = dynamic_cast<juce::Timer*> (component))
+                timer->startTimer (it->timerInterval);
+        }
+
+        suspendedComponents.clear();
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,71 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Implement this in a compared component, or any component inside
+     * it, to be told when a SplitView hides it, so it can pause its own work.
+     * @details Only used once SplitView::setSuspendHiddenComponents() is
+     * enabled. A suspendable component is responsible for everything below it:
+     * its children are not visited, and its own timer is left alone.
+     */
+    class SplitViewSuspendable
+    {
+    public:
+        virtual ~SplitViewSuspendable() = default;
+
+        /** Called on the message thread when the component's side is hidden. */
+        virtual void splitViewSuspended() = 0;
+
+        /** Called on the message thread when the side is shown again, or the view lets go of it. */
+        virtual void splitViewResumed() = 0;
+    };
+
+    /**
+     * @brief Pauses the work of a component tree that isn't on screen, and
+     * resumes it in reverse order.
+     * @details SplitViewSuspendable components are suspended through the
+     * interface. Any other component that is also a running juce::Timer has
+     * its timer stopped, and restarted later with the same interval. Other
+     * sources of work, such as a HighResolutionTimer or a VBlankAttachment,
+     * need SplitViewSuspendable. Components deleted while suspended are
+     * skipped when resuming.
+     */
+    class SubtreeSuspender
+    {
+    public:
+        SubtreeSuspender() = default;
+        ~SubtreeSuspender() { resume(); }
+
+        /** Suspends root and everything below it. Does nothing if already suspended. */
+        void suspend (juce::Component& root);
+
+        /** Resumes whatever suspend() paused. Does nothing if not suspended. */
+        void resume();
+
+        bool isSuspended() const { return suspended; }
+
+    private:
+        void suspendComponent (juce::Component& component);
+
+        struct SuspendedComponent
+        {
+            juce::Component::SafePointer<juce::Component> component;
+            SplitViewSuspendable* suspendable = nullptr; // Otherwise the component is a stopped timer
+            int timerInterval = 0;
+        };
+
+        std::vector<SuspendedComponent> suspendedComponents;
+        bool suspended = false;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SubtreeSuspender)
+    };
+
+} // namespace BogrenDigital
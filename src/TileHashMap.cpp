@@ -0,0 +1,197 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    TileGrid::TileGrid (int frameWidth, int frameHeight)
+        : width (juce::jmax (0, frameWidth)),
+          height (juce::jmax (0, frameHeight)),
+          numTilesX ((width + tileSize - 1) / tileSize),
+          numTilesY ((height + tileSize - 1) / tileSize)
+    {
+    }
+
+    juce::Rectangle<int> TileGrid::getTileBounds (int index) const
+    {
+        jassert (juce::isPositiveAndBelow (index, getNumTiles()));
+        const auto x = (index % numTilesX) * tileSize;
+        const auto y = (index / numTilesX) * tileSize;
+        return juce::Rectangle<int> (x, y, tileSize, tileSize).getIntersection ({ 0, 0, width, height });
+    }
+
+    void TileGrid::addTilesIntersecting (juce::Rectangle<int> area, std::vector<int>& tiles) const
+    {
+        area = area.getIntersection ({ 0, 0, width, height });
+        if (area.isEmpty())
+            return;
+
+        const auto firstX = area.getX() / tileSize;
+        const auto lastX = (area.getRight() - 1) / tileSize;
+        const auto firstY = area.getY() / tileSize;
+        const auto lastY = (area.getBottom() - 1) / tileSize;
+
+        for (auto ty = firstY; ty <= lastY; ++ty)
+            for (auto tx = firstX; tx <= lastX; ++tx)
+                tiles.push_back (ty * numTilesX + tx);
+    }
+
+    //==============================================================================
+    void TileHashMap::update (const juce::Image& frame, const juce::RectangleList<int>& repaintedArea, WorkerPool& pool)
+    {
+        jassert (frame.getFormat() == juce::Image::ARGB);
+
+        candidateTiles.clear();
+
+        const TileGrid frameGrid (frame.getWidth(), frame.getHeight());
+        if (frameGrid != grid || hashes.empty())
+        {
+            grid = frameGrid;
+            hashes.assign ((size_t) grid.getNumTiles(), 0);
+            versions.assign ((size_t) grid.getNumTiles(), 0);
+            ++epoch;
+            grid.addTilesIntersecting (frame.getBounds(), candidateTiles);
+        }
+        else
+        {
+            for (const auto& area : repaintedArea)
+                grid.addTilesIntersecting (area, candidateTiles);
+
+            std::sort (candidateTiles.begin(), candidateTiles.end());
+            candidateTiles.erase (std::unique (candidateTiles.begin(), candidateTiles.end()), candidateTiles.end());
+        }
+
+        if (candidateTiles.empty())
+            return;
+
+        const juce::Image::BitmapData data (frame, juce::Image::BitmapData::readOnly);
+        pool.parallelFor ((int) candidateTiles.size(), 8, [&] (int begin, int end) {
+            for (auto i = begin; i < end; ++i)
+            {
+                const auto index = (size_t) candidateTiles[(size_t) i];
+                const auto hash = hashArea (data, grid.getTileBounds ((int) index));
+                if (hash != hashes[index])
+                {
+                    hashes[index] = hash;
+                    ++versions[index];
+                }
+            }
+        });
+    }
+
+    void TileHashMap::reset()
+    {
+        grid = {};
+        hashes.clear();
+        versions.clear();
+        ++epoch;
+    }
+
+    juce::uint64 TileHashMap::hashArea (const juce::Image::BitmapData& frame, juce::Rectangle<int> area) noexcept
+    {
+        constexpr juce::uint64 prime1 = 0x9E3779B185EBCA87ull;
+        constexpr juce::uint64 prime2 = 0xC2B2AE3D27D4EB4Full;
+        constexpr juce::uint64 prime3 = 0x165667B19E3779F9ull;
+        constexpr juce::uint64 prime4 = 0x85EBCA77C2B2AE63ull;
+        constexpr juce::uint64 prime5 = 0x27D4EB2F165667C5ull;
+
+        const auto rotateLeft = [] (juce::uint64 value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+        const auto round = [&] (juce::uint64 acc, juce::uint64 lane) { return rotateLeft (acc + lane * prime2, 31) * prime1; };
+        const auto read64 = [] (const juce::uint8* p) {
+            juce::uint64 value;
+            std::memcpy (&value, p, sizeof (value));
+            return value;
+        };
+
+        juce::uint64 acc[4] = { prime1 + prime2, prime2, 0, 0 - prime1 };
+        const auto rowBytes = area.getWidth() * frame.pixelStride;
+
+        // Each row is streamed through the same four accumulators as if the
+        // tile's rows were stored contiguously
+        for (auto y = area.getY(); y < area.getBottom(); ++y)
+        {
+            const auto* row = frame.getPixelPointer (area.getX(), y);
+            auto i = 0;
+
+            for (; i + 32 <= rowBytes; i += 32)
+            {
+                acc[0] = round (acc[0], read64 (row + i));
+                acc[1] = round (acc[1], read64 (row + i + 8));
+                acc[2] = round (acc[2], read64 (row + i + 16));
+                acc[3] = round (acc[3], read64 (row + i + 24));
+            }
+
+            for (; i + 8 <= rowBytes; i += 8)
+                acc[(i / 8) & 3] = round (acc[(i / 8) & 3], read64 (row + i));
+
+            for (; i + 4 <= rowBytes; i += 4)
+            {
+                juce::uint32 value;
+                std::memcpy (&value, row + i, sizeof (value));
+                acc[0] = rotateLeft (acc[0] ^ ((juce::uint64) value * prime1), 23) * prime2 + prime3;
+            }
+        }
+
+        auto hash = rotateLeft (acc[0], 1) + rotateLeft (acc[1], 7) + rotateLeft (acc[2], 12) + rotateLeft (acc[3], 18);
+        for (auto lane : acc)
+            hash = (hash ^ round (0, lane)) * prime1 + prime4;
+
+        hash += prime5 + ((juce::uint64) area.getWidth() << 32 | (juce::uint64) area.getHeight());
+
+        hash ^= hash >> 33;
+        hash *= prime2;
+        hash ^= hash >> 29;
+        hash *= prime3;
+        hash ^= hash >> 32;
+        return hash;
+    }
+
+    //==============================================================================
+    std::vector<int> TileHashMap::DirtyTracker::takeDirtyTiles (const TileHashMap& a, const TileHashMap& b)
+    {
+        const auto numTiles = a.grid.getNumTiles();
+        std::vector<int> dirtyTiles;
+
+        if (a.grid != b.grid)
+        {
+            // The frames can't be compared tile by tile, so nothing is tracked
+            valid = false;
+            dirtyTiles.resize ((size_t) numTiles);
+            std::iota (dirtyTiles.begin(), dirtyTiles.end(), 0);
+            return dirtyTiles;
+        }
+
+        if (!valid || seenEpochA != a.epoch || seenEpochB != b.epoch || (int) seenA.size() != numTiles)
+        {
+            dirtyTiles.resize ((size_t) numTiles);
+            std::iota (dirtyTiles.begin(), dirtyTiles.end(), 0);
+        }
+        else
+        {
+            for (auto i = 0; i < numTiles; ++i)
+                if (a.versions[(size_t) i] != seenA[(size_t) i] || b.versions[(size_t) i] != seenB[(size_t) i])
+                    dirtyTiles.push_back (i);
+        }
+
+        seenA = a.versions;
+        seenB = b.versions;
+        seenEpochA = a.epoch;
+        seenEpochB = b.epoch;
+        valid = true;
+        return dirtyTiles;
+    }
+
+    std::vector<int> TileHashMap::DirtyTracker::takeDirtyTiles (const TileHashMap& map)
+    {
+        return takeDirtyTiles (map, map);
+    }
+
+    void TileHashMap::DirtyTracker::reset()
+    {
+        valid = false;
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,101 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Splits a frame into fixed-size square tiles, numbered row by row.
+     */
+    struct TileGrid
+    {
+        static constexpr int tileSize = 64;
+
+        TileGrid() = default;
+        TileGrid (int frameWidth, int frameHeight);
+
+        int getNumTiles() const { return numTilesX * numTilesY; }
+        juce::Rectangle<int> getTileBounds (int index) const;
+
+        /** Appends the indices of all tiles that intersect area to tiles. */
+        void addTilesIntersecting (juce::Rectangle<int> area, std::vector<int>& tiles) const;
+
+        bool operator== (const TileGrid& other) const { return width == other.width && height == other.height; }
+        bool operator!= (const TileGrid& other) const { return !operator== (other); }
+
+        int width = 0, height = 0;
+        int numTilesX = 0, numTilesY = 0;
+    };
+
+    /**
+     * @brief Keeps a fast 64-bit hash of every tile of a frame, and a version
+     * number per tile that is bumped whenever the tile's pixels change.
+     * @details Only the tiles inside the areas reported as repainted are
+     * rehashed, so the cost of an update follows the size of the repainted
+     * area rather than the size of the frame. Consumers keep a DirtyTracker
+     * to find out which tiles changed since they last looked.
+     */
+    class TileHashMap
+    {
+    public:
+        TileHashMap() = default;
+
+        /**
+         * @brief Rehashes the tiles of frame that intersect repaintedArea,
+         * given in frame pixels.
+         * @details A frame of a different size resets the map and marks every
+         * tile as changed.
+         */
+        void update (const juce::Image& frame, const juce::RectangleList<int>& repaintedArea, WorkerPool& pool);
+
+        /** Forgets all hashes, so the next update treats every tile as changed. */
+        void reset();
+
+        const TileGrid& getGrid() const { return grid; }
+        juce::uint32 getTileVersion (int index) const { return versions[(size_t) index]; }
+
+        /** Changes each time the grid is rebuilt. */
+        juce::uint32 getEpoch() const { return epoch; }
+
+        /** Returns an xxHash64-style hash of the pixels of area in frame. */
+        static juce::uint64 hashArea (const juce::Image::BitmapData& frame, juce::Rectangle<int> area) noexcept;
+
+        /**
+         * @brief Remembers which tile versions a consumer has already seen, for
+         * one or two TileHashMaps sharing the same grid.
+         */
+        class DirtyTracker
+        {
+        public:
+            /**
+             * @brief Returns the tiles that changed in a or b since the last call,
+             * and marks them as seen. Every tile is returned on the first call and
+             * after either map was rebuilt or the tracker was reset.
+             */
+            std::vector<int> takeDirtyTiles (const TileHashMap& a, const TileHashMap& b);
+            std::vector<int> takeDirtyTiles (const TileHashMap& map);
+
+            void reset();
+
+        private:
+            std::vector<juce::uint32> seenA, seenB;
+            juce::uint32 seenEpochA = 0, seenEpochB = 0;
+            bool valid = false;
+        };
+
+    private:
+        TileGrid grid;
+        std::vector<juce::uint64> hashes;
+        std::vector<juce::uint32> versions;
+        juce::uint32 epoch = 0;
+        std::vector<int> candidateTiles;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TileHashMap)
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,74 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+namespace BogrenDigital
+{
+
+    WorkerPool::WorkerPool()
+        : parallelPool (juce::jmax (1, juce::SystemStats::getNumCpus() - 1)),
+          backgroundPool (juce::jmax (1, juce::SystemStats::getNumCpus() / 4))
+    {
+    }
+
+    void WorkerPool::addBackgroundJob (std::function<void()> job)
+    {
+        backgroundPool.addJob (std::move (job));
+    }
+
+    void WorkerPool::parallelFor (int numItems, int grainSize, const std::function<void (int, int)>& body)
+    {
+        if (numItems <= 0)
+            return;
+
+        const auto chunkSize = juce::jmax (1, grainSize, (numItems + getConcurrency() * 4 - 1) / (getConcurrency() * 4));
+        const auto numChunks = (numItems + chunkSize - 1) / chunkSize;
+
+        if (numChunks == 1)
+        {
+            body (0, numItems);
+            return;
+        }
+
+        // Workers that only get scheduled after all chunks are claimed must not
+        // touch anything owned by the caller, hence the shared state.
+        struct Batch
+        {
+            std::function<void (int, int)> body;
+            int numItems = 0, chunkSize = 0, numChunks = 0;
+            std::atomic<int> nextChunk { 0 }, chunksDone { 0 };
+            juce::WaitableEvent finished;
+
+            void run()
+            {
+                for (;;)
+                {
+                    const auto chunk = nextChunk.fetch_add (1);
+                    if (chunk >= numChunks)
+                        return;
+
+                    const auto begin = chunk * chunkSize;
+                    body (begin, juce::jmin (begin + chunkSize, numItems));
+
+                    if (chunksDone.fetch_add (1) + 1 == numChunks)
+                        finished.signal();
+                }
+            }
+        };
+
+        auto batch = std::make_shared<Batch>();
+        batch->body = body;
+        batch->numItems = numItems;
+        batch->chunkSize = chunkSize;
+        batch->numChunks = numChunks;
+
+        for (auto i = 0; i < juce::jmin (numChunks - 1, parallelPool.getNumThreads()); ++i)
+            parallelPool.addJob ([batch] { batch->run(); });
+
+        batch->run();
+        batch->finished.wait();
+    }
+
+} // namespace BogrenDigital
@@ -0,0 +1,52 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+#pragma once
+
+namespace BogrenDigital
+{
+
+    /**
+     * @brief Worker threads shared by all SplitViews in the process.
+     * @details Use it through juce::SharedResourcePointer<WorkerPool> so that
+     * the threads only exist while at least one user is alive.
+     */
+    class WorkerPool
+    {
+    public:
+        WorkerPool();
+        ~WorkerPool() = default;
+
+        /**
+         * @brief Runs body over the range [0, numItems) split into chunks of at
+         * least grainSize items, and returns once every chunk is done.
+         * @details The calling thread processes chunks too, so the call never
+         * waits for a worker that is still busy with something else.
+         * @param body Called as body (begin, end) for each chunk.
+         */
+        void parallelFor (int numItems, int grainSize, const std::function<void (int, int)>& body);
+
+        /**
+         * @brief Returns the number of threads that can work on a parallelFor,
+         * including the calling thread.
+         */
+        int getConcurrency() const { return parallelPool.getNumThreads() + 1; }
+
+        /**
+         * @brief Queues a long-running job on a separate set of threads, so that
+         * it never delays the chunks of a parallelFor issued while painting.
+         * The job may itself call parallelFor.
+         */
+        void addBackgroundJob (std::function<void()> job);
+
+    private:
+        juce::ThreadPool parallelPool;
+        juce::ThreadPool backgroundPool;
+
+        JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkerPool)
+    };
+
+} // namespace BogrenDigital
@@ -0,0 +1,195 @@
+/*******************************************************************
+* Copyright         : 2025 Bogren Digital / FStreet Media
+* Author            : Bence Kovács
+* License           : GNU General Public License v3.0
+/******************************************************************/
+
+// Checks that FrameRecorder's QOI files decode back to the recorded pixels,
+// with a decoder written from the format specification rather than sharing
+// anything with the encoder.
+
+#include <bd_splitview/bd_splitview.h>
+
+namespace
+{
+    /**
+     * Decodes a QOI file into straight alpha colours, row by row, following
+     * the reference decoder at https://qoiformat.org. Returns nothing if the
+     * file isn't a well-formed QOI image of the expected size.
+     */
+    std::optional<std::vector<juce::Colour>> readQOI (const juce::MemoryBlock& file, int width, int height)
+    {
+        const auto* data = static_cast<const juce::uint8*> (file.getData());
+        const auto size = file.getSize();
+        constexpr size_t headerSize = 14;
+        constexpr juce::uint8 endMarker[] { 0, 0, 0, 0, 0, 0, 0, 1 };
+
+        const auto readBigEndian = [data] (size_t offset) {
+            return (juce::uint32) data[offset] << 24 | (juce::uint32) data[offset + 1] << 16 | (juce::uint32) data[offset + 2] << 8 | data[offset + 3];
+        };
+
+        if (size < headerSize + sizeof (endMarker) || std::memcmp (data, "qoif", 4) != 0
+            || readBigEndian (4) != (juce::uint32) width || readBigEndian (8) != (juce::uint32) height
+            || std::memcmp (data + size - sizeof (endMarker), endMarker, sizeof (endMarker)) != 0)
+            return std::nullopt;
+
+        std::array<std::array<juce::uint8, 4>, 64> index {};
+        std::array<juce::uint8, 4> pixel { 0, 0, 0, 255 }; // r, g, b, a
+        auto run = 0;
+        auto position = headerSize;
+        const auto chunksEnd = size - sizeof (endMarker);
+
+        std::vector<juce::Colour> pixels;
+        pixels.reserve ((size_t) (width * height));
+
+        for (auto i = 0; i < width * height; ++i)
+        {
+            if (run > 0)
+            {
+                --run;
+            }
+            else
+            {
+                if (position >= chunksEnd)
+                    return std::nullopt;
+
+                const auto tag = data[position++];
+                const auto remaining = chunksEnd - position;
+
+                if (tag == 0xfe || tag == 0xff)
+                {
+                    const auto numChannels = tag == 0xfe ? 3u : 4u;
+                    if (remaining < numChannels)
+                        return std::nullopt;
+
+                    for (auto channel = 0u; channel < numChannels; ++channel)
+                        pixel[channel] = data[position++];
+                }
+                else if ((tag & 0xc0) == 0x00)
+                {
+                    pixel = index[tag];
+                }
+                else if ((tag & 0xc0) == 0x40)
+                {
+                    pixel[0] = (juce::uint8) (pixel[0] + ((tag >> 4) & 0x03) - 2);
+                    pixel[1] = (juce::uint8) (pixel[1] + ((tag >> 2) & 0x03) - 2);
+                    pixel[2] = (juce::uint8) (pixel[2] + (tag & 0x03) - 2);
+                }
+                else if ((tag & 0xc0) == 0x80)
+                {
+                    if (remaining < 1)
+                        return std::nullopt;
+
+                    const auto next = data[position++];
+                    const auto dg = (tag & 0x3f) - 32;
+                    pixel[0] = (juce::uint8) (pixel[0] + dg - 8 + ((next >> 4) & 0x0f));
+                    pixel[1] = (juce::uint8) (pixel[1] + dg);
+                    pixel[2] = (juce::uint8) (pixel[2] + dg - 8 + (next & 0x0f));
+                }
+                else
+                {
+                    run = tag & 0x3f;
+                }
+
+                index[(size_t) ((pixel[0] * 3 + pixel[1] * 5 + pixel[2] * 7 + pixel[3] * 11) % 64)] = pixel;
+            }
+
+            pixels.push_back (juce::Colour (pixel[0], pixel[1], pixel[2], pixel[3]));
+        }
+
+        // Every chunk has to have been used
+        if (position != chunksEnd)
+            return std::nullopt;
+
+        return pixels;
+    }
+
+    class FrameRecorderQOITests : public juce::UnitTest
+    {
+    public:
+        FrameRecorderQOITests() : juce::UnitTest ("FrameRecorder QOI", "bd_splitview") {}
+
+        void runTest() override
+        {
+            beginTest ("Null image");
+            {
+                juce::MemoryOutputStream stream;
+                expect (!BogrenDigital::FrameRecorder::writeQOI (juce::Image(), stream));
+            }
+
+            // Between them, these use every QOI chunk
+            juce::Random random (42);
+            constexpr auto size = 97;
+
+            juce::Image noise (juce::Image::ARGB, size, size, true);
+            juce::Image steps (juce::Image::ARGB, size, size, true);
+            juce::Image flat (juce::Image::ARGB, size, size, true);
+            juce::Image palette (juce::Image::ARGB, size, size, true);
+            const juce::Colour colours[] { juce::Colours::red, juce::Colours::transparentBlack, juce::Colour (0x80336699), juce::Colours::white };
+
+            constexpr int ranges[] { 4, 24, 72 };
+            auto stepped = juce::Colour (0xff808080);
+
+            for (auto y = 0; y < size; ++y)
+            {
+                for (auto x = 0; x < size; ++x)
+                {
+                    noise.setPixelAt (x, y, juce::Colour ((juce::uint32) random.nextInt()));
+
+                    // Green steps small enough for the one byte diff chunk, around the edges of the two byte
+                    // one, or past it, with red and blue following it about as closely as the chunk allows
+                    const auto range = ranges[random.nextInt (juce::numElementsInArray (ranges))];
+                    const auto greenStep = random.nextInt (range) - range / 2;
+                    const auto nearGreen = [&] (juce::uint8 value) { return (juce::uint8) (value + greenStep + random.nextInt (20) - 10); };
+                    stepped = juce::Colour (nearGreen (stepped.getRed()), (juce::uint8) (stepped.getGreen() + greenStep), nearGreen (stepped.getBlue()), (juce::uint8) 255);
+                    steps.setPixelAt (x, y, stepped);
+
+                    flat.setPixelAt (x, y, x < size / 3 ? juce::Colours::blue : juce::Colour (0xff102030));
+                    palette.setPixelAt (x, y, colours[random.nextInt (juce::numElementsInArray (colours))]);
+                }
+            }
+
+            // Antialiased, translucent shapes, as a recorded editor has
+            juce::Image drawn (juce::Image::ARGB, 301, 199, true);
+            {
+                juce::Graphics g (drawn);
+                for (auto i = 0; i < 40; ++i)
+                {
+                    g.setColour (juce::Colour ((juce::uint32) random.nextInt()));
+                    g.fillEllipse (random.nextFloat() * 300.0f, random.nextFloat() * 200.0f, 5.0f + random.nextFloat() * 60.0f, 5.0f + random.nextFloat() * 60.0f);
+                }
+            }
+
+            expectRoundTrip ("Noise with random alpha", noise);
+            expectRoundTrip ("Small and large steps", steps);
+            expectRoundTrip ("Flat areas", flat);
+            expectRoundTrip ("Repeated colours", palette);
+            expectRoundTrip ("Drawn shapes", drawn);
+            expectRoundTrip ("Single pixel", juce::Image (juce::Image::ARGB, 1, 1, true));
+        }
+
+    private:
+        void expectRoundTrip (const juce::String& name, const juce::Image& image)
+        {
+            beginTest (name);
+
+            juce::MemoryOutputStream stream;
+            expect (BogrenDigital::FrameRecorder::writeQOI (image, stream));
+
+            const auto decoded = readQOI (stream.getMemoryBlock(), image.getWidth(), image.getHeight());
+            expect (decoded.has_value(), "Not a well-formed QOI file of the image's size");
+            if (!decoded)
+                return;
+
+            // QOI stores straight alpha, as getPixelAt() returns it
+            auto numDifferent = 0;
+            for (auto y = 0; y < image.getHeight(); ++y)
+                for (auto x = 0; x < image.getWidth(); ++x)
+                    numDifferent += (*decoded)[(size_t) (y * image.getWidth() + x)] != image.getPixelAt (x, y) ? 1 : 0;
+
+            expectEquals (numDifferent, 0, "Pixels that decoded differently");
+        }
+    };
+
+    FrameRecorderQOITests frameRecorderQOITests;
+} // namespace